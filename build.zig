@@ -41,16 +41,31 @@
 const std = @import("std");
 const builtin = @import("builtin");
 
+const Sdl2LinkMode = enum {
+    // Find SDL2 at runtime, and skip the SDL2 backend if it isn't there
+    dynamic,
+    // Link SDL2 with the library
+    direct,
+};
+
 pub fn build(b: *std.Build) !void {
     const target = b.standardTargetOptions(.{});
     const optimize = b.standardOptimizeOption(.{});
     const shared = b.option(bool, "shared", "Build a shared library. Default: false") orelse false;
     // if these are not set, leave them undefined so the actual C code can determine the defaults
     const have_window_sdl2: ?bool = b.option(bool, "have_window_sdl2", "see settings.md");
+    const have_window_none: ?bool = b.option(bool, "have_window_none", "see settings.md");
     const enable_error_external: ?bool = b.option(bool, "enable_error_external", "see settings.md");
     const enable_error_assert: ?bool = b.option(bool, "enable_error_assert", "see settings.md");
     const enable_error_user: ?bool = b.option(bool, "enable_error_user", "see settings.md");
+    const enable_error_sanitize: ?bool = b.option(bool, "enable_error_sanitize", "see settings.md");
+    const enable_error_validate: ?bool = b.option(bool, "enable_error_validate", "see settings.md");
     const use_custom_platform_implementation: ?bool = b.option(bool, "use_custom_platform_implementation", "see settings.md");
+    const use_builtin_memory_functions: ?bool = b.option(bool, "use_builtin_memory_functions", "see settings.md");
+    const direct_window_backend: ?bool = b.option(bool, "direct_window_backend", "see settings.md");
+    const log_min_level: ?u8 = b.option(u8, "log_min_level", "see settings.md");
+    const opengl_probe: ?u8 = b.option(u8, "opengl_probe", "see settings.md");
+    const sdl2_link_mode: Sdl2LinkMode = b.option(Sdl2LinkMode, "sdl2_link_mode", "see settings.md. Default: dynamic") orelse .dynamic;
 
     const link_libc = switch (target.result.os.tag) {
         // windows -> does not need libc
@@ -66,11 +81,14 @@ pub fn build(b: *std.Build) !void {
         .pic = if (shared) true else null,
     });
 
-    var flags = try std.ArrayList([]const u8).initCapacity(b.allocator, 8);
+    var flags = try std.ArrayList([]const u8).initCapacity(b.allocator, 16);
 
     if (have_window_sdl2) |enable| {
         flags.appendAssumeCapacity(if (enable) "-DPINC_HAVE_WINDOW_SDL2=ON" else "-DPINC_HAVE_WINDOW_SDL2=OFF");
     }
+    if (have_window_none) |enable| {
+        flags.appendAssumeCapacity(if (enable) "-DPINC_HAVE_WINDOW_NONE=ON" else "-DPINC_HAVE_WINDOW_NONE=OFF");
+    }
     if (enable_error_external) |enable| {
         flags.appendAssumeCapacity(if (enable) "-DPINC_ENABLE_ERROR_EXTERNAL=ON" else "-DPINC_ENABLE_ERROR_EXTERNAL=OFF");
     }
@@ -80,16 +98,52 @@ pub fn build(b: *std.Build) !void {
     if (enable_error_user) |enable| {
         flags.appendAssumeCapacity(if (enable) "-DPINC_ENABLE_ERROR_USER=ON" else "-DPINC_ENABLE_ERROR_USER=OFF");
     }
+    if (enable_error_sanitize) |enable| {
+        flags.appendAssumeCapacity(if (enable) "-DPINC_ENABLE_ERROR_SANITIZE=ON" else "-DPINC_ENABLE_ERROR_SANITIZE=OFF");
+    }
+    if (enable_error_validate) |enable| {
+        flags.appendAssumeCapacity(if (enable) "-DPINC_ENABLE_ERROR_VALIDATE=ON" else "-DPINC_ENABLE_ERROR_VALIDATE=OFF");
+    }
     if (use_custom_platform_implementation) |enable| {
         flags.appendAssumeCapacity(if (enable) "-DPINC_USE_CUSTOM_PLATFORM_IMPLEMENTATION=ON" else "-PINC_USE_CUSTOM_PLATFORM_IMPLEMENTATION=OFF");
     }
 
+    if (use_builtin_memory_functions) |enable| {
+        flags.appendAssumeCapacity(if (enable) "-DPINC_USE_BUILTIN_MEMORY_FUNCTIONS=ON" else "-DPINC_USE_BUILTIN_MEMORY_FUNCTIONS=OFF");
+    }
+
+    if (direct_window_backend) |enable| {
+        flags.appendAssumeCapacity(if (enable) "-DPINC_DIRECT_WINDOW_BACKEND=ON" else "-DPINC_DIRECT_WINDOW_BACKEND=OFF");
+    }
+
+    if (log_min_level) |level| {
+        flags.appendAssumeCapacity(b.fmt("-DPINC_LOG_MIN_LEVEL={d}", .{level}));
+    }
+
+    if (opengl_probe) |mode| {
+        flags.appendAssumeCapacity(b.fmt("-DPINC_OPENGL_PROBE={d}", .{mode}));
+    }
+
+    if (sdl2_link_mode == .direct) {
+        flags.appendAssumeCapacity("-DPINC_SDL2_LINK_DIRECT=ON");
+        lib_mod.linkSystemLibrary("SDL2", .{});
+    }
+
+    // The platform layer's threads, mutexes and condition variables are pthreads everywhere but Windows
+    if (target.result.os.tag != .windows) {
+        lib_mod.linkSystemLibrary("pthread", .{});
+    }
+
     lib_mod.addCSourceFiles(.{
         .files = &[_][]const u8{
             // Actual source files
             "src/pinc_main.c",
+            "src/pinc_log.c",
+            "src/pinc_capability_cache.c",
             "src/platform/pinc_platform.c",
+            "src/platform/pinc_cpu.c",
             "src/pinc_sdl2.c",
+            "src/pinc_none.c",
             "src/libs/pinc_arena.c",
             "src/libs/pinc_string.c",
             "src/libs/pinc_utf8.c",
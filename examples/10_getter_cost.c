@@ -0,0 +1,46 @@
+#include "example.h"
+#include "pinc.h"
+#include <time.h>
+
+// Measure what a single call to an event getter costs, which is almost entirely the error checking that goes along with it.
+// Build Pinc at each validation tier (see settings.md) and run this against each one to compare them.
+// The headless backend fills the event buffer with synthetic key repeats, then the same events are read over and over without stepping.
+
+#define EVENTS 1024
+#define PASSES 4096
+
+int main(void) {
+    pincPreinitSetErrorCallback(exampleErrorCallback);
+    pincInitIncomplete();
+    if(pincLastErrorCode() != PincErrorCode_pass) { pincDeinit(); return 100; }
+    pincInitComplete(PincWindowBackend_none, PincGraphicsApi_raw, 0);
+    if(pincLastErrorCode() != PincErrorCode_pass) { pincDeinit(); return 100; }
+
+    pincHeadlessSetSyntheticEvents(PincHeadlessSynthetic_keyRepeat, 0, EVENTS);
+    pincStep();
+    pincHeadlessSetSyntheticEvents(PincHeadlessSynthetic_keyRepeat, 0, 0);
+    uint32_t num_events = pincEventGetNum();
+    if(num_events != EVENTS) {
+        printf("Expected %u events, got %u\n", EVENTS, num_events);
+        pincDeinit();
+        return 1;
+    }
+
+    // The checksum is printed so none of the calls can be optimized away
+    uint64_t checksum = 0;
+    clock_t start = clock();
+    for(uint32_t pass=0; pass<PASSES; ++pass) {
+        for(uint32_t i=0; i<num_events; ++i) {
+            checksum += pincEventGetType(i);
+            checksum += (uint64_t)pincEventGetTimestampUnixMillis(i);
+        }
+    }
+    clock_t ticks = clock() - start;
+    // Two getters per event per pass
+    double calls = (double)PASSES * (double)num_events * 2.0;
+    double nanos = (double)ticks * (1e9 / (double)CLOCKS_PER_SEC) / calls;
+    printf("%.0f getter calls, %.2f ns/call (checksum %llu)\n", calls, nanos, (unsigned long long)checksum);
+
+    pincDeinit();
+    return 0;
+}
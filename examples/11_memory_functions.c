@@ -0,0 +1,98 @@
+// Not really an example - this compares Pinc's built-in memory functions (PINC_USE_BUILTIN_MEMORY_FUNCTIONS) against the C library's.
+// Whether posix keeps using libc by default is decided by these numbers, so this is here to re-check that decision on new compilers and CPUs.
+// It includes the built-in implementations directly instead of linking Pinc, so both versions are in the same program no matter how Pinc was configured.
+
+#include "platform/pinc_platform_mem.c.inc"
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+// Enough bytes per measurement that clock() has something to measure
+#define BYTES_PER_RUN (256u * 1024u * 1024u)
+#define MAX_SIZE 4096
+
+static size_t const sizes[] = {16, 64, 256, 4096};
+#define SIZES_NUM (sizeof(sizes) / sizeof(sizes[0]))
+
+// Called through pointers so the compiler can't replace the libc calls with inline code for a size it can see
+typedef void (*CopyFn)(void const* src, void* dst, size_t len);
+typedef void (*SetFn)(uint8_t value, void* dst, size_t len);
+typedef size_t (*StrlenFn)(char const* str);
+
+static void libcCopy(void const* src, void* dst, size_t len) { memcpy(dst, src, len); }
+static void libcSet(uint8_t value, void* dst, size_t len) { memset(dst, value, len); }
+static size_t libcStrlen(char const* str) { return strlen(str); }
+
+static void pincCopy(void const* src, void* dst, size_t len) { pincMemCopy(src, dst, len); }
+
+static CopyFn volatile copyFns[2] = {libcCopy, pincCopy};
+static SetFn volatile setFns[2] = {libcSet, pincMemSet};
+static StrlenFn volatile strlenFns[2] = {libcStrlen, pincStringLen};
+
+// One byte past a 16 byte boundary, so neither side gets the aligned fast path for free
+static uint8_t srcBuffer[MAX_SIZE + 64];
+static uint8_t dstBuffer[MAX_SIZE + 64];
+
+static double gigabytesPerSecond(clock_t ticks, size_t bytes) {
+    double seconds = (double)ticks / (double)CLOCKS_PER_SEC;
+    if(seconds <= 0) {
+        return 0;
+    }
+    return (double)bytes / seconds / 1e9;
+}
+
+int main(void) {
+    uint8_t* src = (uint8_t*)(((uintptr_t)srcBuffer + 15) & ~(uintptr_t)15) + 1;
+    uint8_t* dst = (uint8_t*)(((uintptr_t)dstBuffer + 15) & ~(uintptr_t)15) + 1;
+    // The checksum is printed so none of the work can be optimized away
+    size_t checksum = 0;
+    char const* const names[2] = {"libc", "pinc"};
+    printf("GB/s at");
+    for(size_t s=0; s<SIZES_NUM; ++s) {
+        printf(" %zu", sizes[s]);
+    }
+    printf(" bytes, unaligned\n");
+    for(int impl=0; impl<2; ++impl) {
+        printf("copy    %s", names[impl]);
+        for(size_t s=0; s<SIZES_NUM; ++s) {
+            size_t iterations = BYTES_PER_RUN / sizes[s];
+            clock_t start = clock();
+            for(size_t i=0; i<iterations; ++i) {
+                copyFns[impl](src, dst, sizes[s]);
+            }
+            checksum += dst[sizes[s] - 1];
+            printf(" %6.1f", gigabytesPerSecond(clock() - start, iterations * sizes[s]));
+        }
+        printf("\n");
+    }
+    for(int impl=0; impl<2; ++impl) {
+        printf("set     %s", names[impl]);
+        for(size_t s=0; s<SIZES_NUM; ++s) {
+            size_t iterations = BYTES_PER_RUN / sizes[s];
+            clock_t start = clock();
+            for(size_t i=0; i<iterations; ++i) {
+                setFns[impl]((uint8_t)i, dst, sizes[s]);
+            }
+            checksum += dst[0];
+            printf(" %6.1f", gigabytesPerSecond(clock() - start, iterations * sizes[s]));
+        }
+        printf("\n");
+    }
+    for(int impl=0; impl<2; ++impl) {
+        printf("strlen  %s", names[impl]);
+        for(size_t s=0; s<SIZES_NUM; ++s) {
+            pincMemSet('a', src, sizes[s]);
+            src[sizes[s]] = 0;
+            size_t iterations = BYTES_PER_RUN / sizes[s];
+            clock_t start = clock();
+            for(size_t i=0; i<iterations; ++i) {
+                checksum += strlenFns[impl]((char const*)src);
+            }
+            printf(" %6.1f", gigabytesPerSecond(clock() - start, iterations * sizes[s]));
+        }
+        printf("\n");
+    }
+    printf("(checksum %zu)\n", checksum);
+    return 0;
+}
@@ -0,0 +1,49 @@
+#include "example.h"
+#include "pinc.h"
+
+// Run a window for a fixed number of frames, and make sure the main loop stops allocating memory once it has warmed up.
+// It uses the headless window backend and needs no user input, so it runs anywhere, including CI machines with no display.
+// The steady_state_check target builds and runs it.
+
+#define WARMUP_FRAMES 60
+#define TOTAL_FRAMES 600
+
+int main(void) {
+    pincPreinitSetErrorCallback(exampleErrorCallback);
+    pincInitIncomplete();
+    if(pincLastErrorCode() != PincErrorCode_pass) { pincDeinit(); return 100; }
+    pincInitComplete(PincWindowBackend_none, PincGraphicsApi_raw, 0);
+    if(pincLastErrorCode() != PincErrorCode_pass) { pincDeinit(); return 100; }
+    PincWindowHandle window = pincWindowCreateIncomplete();
+    pincWindowSetTitle(window, "Steady state", 0);
+    pincWindowComplete(window);
+    if(pincLastErrorCode() != PincErrorCode_pass) { pincDeinit(); return 100; }
+
+    uint32_t allocatingFrames = 0;
+    for(uint32_t frame=0; frame<TOTAL_FRAMES; ++frame) {
+        pincStep();
+        // The counter is for the previous step, so the first steady state step is checked one frame after it was marked
+        if(frame == WARMUP_FRAMES) {
+            pincMarkSteadyState();
+        } else if(frame > WARMUP_FRAMES + 1) {
+            uint32_t allocations = pincQueryStepRootAllocations();
+            if(allocations != 0) {
+                printf("Frame %u made %u root allocations\n", frame-1, allocations);
+                allocatingFrames++;
+            }
+        }
+        uint32_t num_events = pincEventGetNum();
+        for(uint32_t i=0; i<num_events; ++i) {
+            if(pincEventGetType(i) == PincEventType_closeSignal) {
+                // Closing the window early is fine, it just means fewer frames get checked
+                frame = TOTAL_FRAMES;
+            }
+        }
+        pincWindowPresentFramebuffer(window);
+    }
+    pincClearSteadyState();
+    printf("%u frames allocated memory after warming up\n", allocatingFrames);
+    pincWindowDeinit(window);
+    pincDeinit();
+    return allocatingFrames == 0 ? 0 : 1;
+}
@@ -0,0 +1,41 @@
+#include "example.h"
+#include "pinc.h"
+
+// Cap the frame rate at 60 without vsync, and print how well the pacer keeps up.
+// Like the steady state example this doesn't need any input, so it runs fine with SDL_VIDEODRIVER=dummy
+
+#define TOTAL_FRAMES 600
+#define TARGET_FPS 60
+
+int main(void) {
+    pincPreinitSetErrorCallback(exampleErrorCallback);
+    pincInitIncomplete();
+    if(pincLastErrorCode() != PincErrorCode_pass) { pincDeinit(); return 100; }
+    pincInitComplete(PincWindowBackend_any, PincGraphicsApi_any, 0);
+    if(pincLastErrorCode() != PincErrorCode_pass) { pincDeinit(); return 100; }
+    PincWindowHandle window = pincWindowCreateIncomplete();
+    pincWindowSetTitle(window, "Frame pacer", 0);
+    pincWindowComplete(window);
+    if(pincLastErrorCode() != PincErrorCode_pass) { pincDeinit(); return 100; }
+    // The pacer is what caps the frame rate here, vsync would hide how well it does
+    pincSetVsync(false);
+    pincFramePacerSetPeriodNanos(1000000000 / TARGET_FPS);
+
+    for(uint32_t frame=0; frame<TOTAL_FRAMES; ++frame) {
+        pincStep();
+        uint32_t num_events = pincEventGetNum();
+        for(uint32_t i=0; i<num_events; ++i) {
+            if(pincEventGetType(i) == PincEventType_closeSignal) {
+                frame = TOTAL_FRAMES;
+            }
+        }
+        pincFramePacerWait();
+        pincWindowPresentFramebuffer(window);
+        if(frame % TARGET_FPS == TARGET_FPS - 1) {
+            printf("frame time: %.3f ms, jitter: %.3f ms\n", (double)pincFramePacerQueryFrameTimeNanos() / 1000000.0, (double)pincFramePacerQueryJitterNanos() / 1000000.0);
+        }
+    }
+    pincWindowDeinit(window);
+    pincDeinit();
+    return 0;
+}
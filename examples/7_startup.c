@@ -0,0 +1,71 @@
+// NOLINTBEGIN: As examples, these are really only subject to what matters for demonstrating features, not for 'real' code
+
+#include "example.h"
+#include "pinc.h"
+#include <pinc_opengl.h>
+#include <string.h>
+#include <time.h>
+
+// Go from nothing to the first frame on screen (init, window, OpenGL context, present) and print where the time went.
+// This doesn't need any user input, so it can be run headless with SDL's dummy or offscreen video driver:
+// SDL_VIDEODRIVER=offscreen ./example_startup
+// The dummy driver has no OpenGL, so with that one the context phase is skipped.
+// Without SDL2 at all, it falls back to the headless window backend.
+// Pass "async" to initialize with pincInitIncompleteAsync, which overlaps the loading with a stand-in for the application's own startup.
+
+static char const* const phaseNames[PincStartupPhase_count] = {
+    [PincStartupPhase_initIncomplete] = "pincInitIncomplete",
+    [PincStartupPhase_libraryLoad] = "  library load",
+    [PincStartupPhase_backendInit] = "  backend init",
+    [PincStartupPhase_framebufferFormats] = "framebuffer formats",
+    [PincStartupPhase_initComplete] = "pincInitComplete",
+    [PincStartupPhase_windowComplete] = "window",
+    [PincStartupPhase_openglContextComplete] = "OpenGL context",
+    [PincStartupPhase_firstPresent] = "first present",
+    [PincStartupPhase_timeToFirstFrame] = "time to first frame",
+};
+
+int main(int argc, char** argv) {
+    bool async = argc > 1 && strcmp(argv[1], "async") == 0;
+    pincPreinitSetErrorCallback(exampleErrorCallback);
+    if(async) {
+        pincInitIncompleteAsync();
+        // The application's own startup. It isn't counted in the pincInitIncomplete phase.
+        clock_t busy_until = clock() + CLOCKS_PER_SEC / 50;
+        while(clock() < busy_until) {}
+        pincInitWait();
+    } else {
+        pincInitIncomplete();
+    }
+    if(pincLastErrorCode() != PincErrorCode_pass) { pincDeinit(); return 100; }
+    PincWindowBackend backend = pincQueryWindowBackendSupport(PincWindowBackend_sdl2) ? PincWindowBackend_sdl2 : PincWindowBackend_none;
+    bool opengl = pincQueryGraphicsApiSupport(backend, PincGraphicsApi_opengl);
+    pincInitComplete(backend, opengl ? PincGraphicsApi_opengl : PincGraphicsApi_raw, 0);
+    if(pincLastErrorCode() != PincErrorCode_pass) { pincDeinit(); return 100; }
+    PincWindowHandle window = pincWindowCreateIncomplete();
+    pincWindowSetTitle(window, "Startup", 0);
+    pincWindowComplete(window);
+    if(pincLastErrorCode() != PincErrorCode_pass) { pincDeinit(); return 100; }
+    if(opengl) {
+        PincOpenglContextHandle gl_context = pincOpenglCreateContextIncomplete();
+        pincOpenglCompleteContext(gl_context);
+        if(pincLastErrorCode() != PincErrorCode_pass) { pincDeinit(); return 100; }
+        pincOpenglMakeCurrent(window, gl_context);
+    }
+    pincStep();
+    pincWindowPresentFramebuffer(window);
+
+    int64_t timings[PincStartupPhase_count];
+    uint32_t num = pincQueryStartupTimings(timings, PincStartupPhase_count);
+    if(num > PincStartupPhase_count) {
+        num = PincStartupPhase_count;
+    }
+    for(uint32_t i=0; i<num; ++i) {
+        printf("%-22s %10.3f ms\n", phaseNames[i], (double)timings[i] / 1000000.0);
+    }
+    pincWindowDeinit(window);
+    pincDeinit();
+    return 0;
+}
+
+// NOLINTEND
@@ -0,0 +1,87 @@
+#include "example.h"
+#include "pinc.h"
+
+// Render a few frames with the headless window backend, and check what was presented by reading it back.
+// This needs no display at all, not even SDL's dummy video driver. The window is only pixels in memory.
+// It runs twice: once the plain way, and once in its own instance, initialized asynchronously.
+
+#define WIDTH 64
+#define HEIGHT 48
+#define FRAMES 8
+
+// Returns the exit code for main
+static int run(bool async) {
+    pincPreinitSetErrorCallback(exampleErrorCallback);
+    if(async) {
+        // The loading happens on another thread, which has to go to the current instance instead of the default one
+        pincInitIncompleteAsync();
+        pincInitWait();
+    } else {
+        pincInitIncomplete();
+    }
+    if(pincLastErrorCode() != PincErrorCode_pass) { pincDeinit(); return 100; }
+    // The headless backend is never the default, so it has to be asked for by name.
+    // The raw graphics api and the default framebuffer format (8 bit RGBA) are the only sensible choices with it.
+    pincInitComplete(PincWindowBackend_none, PincGraphicsApi_raw, 0);
+    if(pincLastErrorCode() != PincErrorCode_pass) { pincDeinit(); return 100; }
+    PincWindowHandle window = pincWindowCreateIncomplete();
+    pincWindowSetTitle(window, "Headless", 0);
+    pincWindowSetWidth(window, WIDTH);
+    pincWindowSetHeight(window, HEIGHT);
+    pincWindowComplete(window);
+    if(pincLastErrorCode() != PincErrorCode_pass) { pincDeinit(); return 100; }
+
+    static uint8_t readback[WIDTH * HEIGHT * 4];
+    uint32_t mismatches = 0;
+    bool running = true;
+    for(uint32_t frame=0; frame<FRAMES && running; ++frame) {
+        pincStep();
+        uint32_t num_events = pincEventGetNum();
+        for(uint32_t i=0; i<num_events; ++i) {
+            if(pincEventGetType(i) == PincEventType_closeSignal) {
+                running = false;
+            }
+        }
+        uint32_t stride = 0;
+        uint8_t* pixels = pincWindowGetPixels(window, &stride);
+        for(uint32_t y=0; y<HEIGHT; ++y) {
+            for(uint32_t x=0; x<WIDTH; ++x) {
+                uint8_t* pixel = pixels + (size_t)y * stride + (size_t)x * 4;
+                pixel[0] = (uint8_t)(x * 4);
+                pixel[1] = (uint8_t)(y * 4);
+                pixel[2] = (uint8_t)(frame * 32);
+                pixel[3] = 255;
+            }
+        }
+        pincWindowPresentFramebuffer(window);
+        pincWindowReadPixels(window, readback, WIDTH * 4);
+        // Spot check one pixel of the frame that was just presented
+        uint8_t const* corner = readback + (size_t)(HEIGHT - 1) * WIDTH * 4 + (size_t)(WIDTH - 1) * 4;
+        if(corner[0] != (uint8_t)((WIDTH - 1) * 4) || corner[1] != (uint8_t)((HEIGHT - 1) * 4) || corner[2] != (uint8_t)(frame * 32)) {
+            mismatches++;
+        }
+        // Pretend the user closed the window halfway through. It arrives with the next pincStep, like a real close would.
+        if(frame == FRAMES / 2) {
+            pincHeadlessInjectCloseSignal(window);
+        }
+    }
+    printf("%u frames read back wrong\n", mismatches);
+    pincWindowDeinit(window);
+    pincDeinit();
+    return (mismatches == 0 && !running) ? 0 : 1;
+}
+
+int main(void) {
+    int result = run(false);
+    if(result != 0) {
+        return result;
+    }
+    PincInstance* instance = pincInstanceCreate();
+    if(!instance) {
+        return 100;
+    }
+    pincInstanceMakeCurrent(instance);
+    result = run(true);
+    pincInstanceDestroy(instance);
+    return result;
+}
@@ -0,0 +1,121 @@
+#include "example.h"
+#include "pinc.h"
+#include <time.h>
+
+// Measure how long Pinc itself takes per event, with nothing else in the way.
+// The headless backend generates a fixed number of synthetic events every step, so the only cost left is Pinc collecting them in pincStep and the application reading them back.
+// clock() measures processor time, which is what matters here since none of this waits on anything.
+
+#define WIDTH 640
+#define HEIGHT 480
+#define EVENTS_PER_STEP 10000
+#define WARMUP_STEPS 16
+#define STEPS 256
+
+// Read every field of every event, like an application that actually handles them would.
+// The checksum is printed so none of it can be optimized away.
+static uint64_t readEvents(void) {
+    uint64_t checksum = 0;
+    uint32_t num_events = pincEventGetNum();
+    for(uint32_t i=0; i<num_events; ++i) {
+        checksum += (uint64_t)pincEventGetTimestampUnixMillis(i);
+        switch(pincEventGetType(i)) {
+            case PincEventType_cursorMove:
+                checksum += pincEventCursorMoveOldX(i) + pincEventCursorMoveOldY(i) + pincEventCursorMoveX(i) + pincEventCursorMoveY(i) + pincEventCursorMoveWindow(i);
+                break;
+            case PincEventType_cursorTransition:
+                checksum += pincEventCursorTransitionOldX(i) + pincEventCursorTransitionOldY(i) + pincEventCursorTransitionOldWindow(i);
+                checksum += pincEventCursorTransitionX(i) + pincEventCursorTransitionY(i) + pincEventCursorTransitionWindow(i);
+                break;
+            case PincEventType_keyboardButton:
+                checksum += pincEventKeyboardButtonKey(i) + pincEventKeyboardButtonState(i) + pincEventKeyboardButtonRepeat(i);
+                break;
+            case PincEventType_resize:
+                checksum += pincEventResizeOldWidth(i) + pincEventResizeOldHeight(i) + pincEventResizeWidth(i) + pincEventResizeHeight(i) + pincEventResizeWindow(i);
+                break;
+            case PincEventType_textInput:
+                checksum += pincEventTextInputCodepoint(i);
+                break;
+            default:
+                break;
+        }
+    }
+    return checksum;
+}
+
+static double nanosPerEvent(clock_t ticks, uint64_t events) {
+    if(events == 0) {
+        return 0;
+    }
+    return (double)ticks * (1e9 / (double)CLOCKS_PER_SEC) / (double)events;
+}
+
+// Returns false if something went wrong
+static bool benchmark(char const* name, PincWindowHandle window, PincHeadlessSynthetic const* kinds, uint32_t kinds_num) {
+    for(uint32_t k=0; k<kinds_num; ++k) {
+        pincHeadlessSetSyntheticEvents(kinds[k], window, EVENTS_PER_STEP / kinds_num);
+    }
+    // Let the event buffers and temp arenas grow to fit first
+    for(uint32_t s=0; s<WARMUP_STEPS; ++s) {
+        pincStep();
+        (void)readEvents();
+    }
+    clock_t step_ticks = 0;
+    clock_t read_ticks = 0;
+    uint64_t events = 0;
+    uint64_t checksum = 0;
+    for(uint32_t s=0; s<STEPS; ++s) {
+        clock_t start = clock();
+        pincStep();
+        clock_t stepped = clock();
+        checksum += readEvents();
+        clock_t read = clock();
+        step_ticks += stepped - start;
+        read_ticks += read - stepped;
+        events += pincEventGetNum();
+    }
+    for(uint32_t k=0; k<kinds_num; ++k) {
+        pincHeadlessSetSyntheticEvents(kinds[k], 0, 0);
+    }
+    // Clear out whatever the last step left behind, so it doesn't count towards the next run
+    pincStep();
+    if(pincLastErrorCode() != PincErrorCode_pass) {
+        return false;
+    }
+    double step_nanos = nanosPerEvent(step_ticks, events);
+    double read_nanos = nanosPerEvent(read_ticks, events);
+    printf("%-12s %10llu events  step %7.2f ns/event  read %7.2f ns/event  total %7.2f ns/event  (checksum %llu)\n",
+        name, (unsigned long long)events, step_nanos, read_nanos, step_nanos + read_nanos, (unsigned long long)checksum);
+    return true;
+}
+
+int main(void) {
+    pincPreinitSetErrorCallback(exampleErrorCallback);
+    pincInitIncomplete();
+    if(pincLastErrorCode() != PincErrorCode_pass) { pincDeinit(); return 100; }
+    pincInitComplete(PincWindowBackend_none, PincGraphicsApi_raw, 0);
+    if(pincLastErrorCode() != PincErrorCode_pass) { pincDeinit(); return 100; }
+    PincWindowHandle window = pincWindowCreateIncomplete();
+    pincWindowSetTitle(window, "Event throughput", 0);
+    pincWindowSetWidth(window, WIDTH);
+    pincWindowSetHeight(window, HEIGHT);
+    pincWindowComplete(window);
+    if(pincLastErrorCode() != PincErrorCode_pass) { pincDeinit(); return 100; }
+
+    PincHeadlessSynthetic const cursor[] = {PincHeadlessSynthetic_cursorMove};
+    PincHeadlessSynthetic const keys[] = {PincHeadlessSynthetic_keyRepeat};
+    PincHeadlessSynthetic const resize[] = {PincHeadlessSynthetic_resize};
+    PincHeadlessSynthetic const text[] = {PincHeadlessSynthetic_textInput};
+    PincHeadlessSynthetic const mixed[] = {PincHeadlessSynthetic_cursorMove, PincHeadlessSynthetic_keyRepeat, PincHeadlessSynthetic_resize, PincHeadlessSynthetic_textInput};
+
+    printf("%u events per step, %u steps each\n", EVENTS_PER_STEP, STEPS);
+    bool ok = benchmark("cursor move", window, cursor, 1)
+        && benchmark("key repeat", window, keys, 1)
+        && benchmark("resize", window, resize, 1)
+        && benchmark("text input", window, text, 1)
+        && benchmark("mixed", window, mixed, 4);
+
+    pincWindowDeinit(window);
+    pincDeinit();
+    return ok ? 0 : 1;
+}
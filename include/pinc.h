@@ -18,7 +18,7 @@
 // Pinc functions will always return from any kind of error - even assert and user errors.
 // When an error occurs:
 // 1. Pinc sets the lastErrorCode, lastErrorMessage, and lastErrorRecoverable flags.
-// 2. Pinc calls the user-defined error callback function (if it is defined).
+// 2. Pinc calls the user-defined error callback function (if it is defined), unless it's the same error as the last one this step (see pincLastErrorRepeatCount).
 // 3. Pinc "safely" returns from the function call, with a (generally well-defined) default result.
 // 4. The program acts on the error. Or not, it's really on the caller to decide what to do (or not do) with errors.
 
@@ -100,10 +100,53 @@ typedef enum {
     /// @brief Represents any backend, or an unknown backend. Generally only works for calling pinc_complete_init.
     PincGraphicsApi_any = 0,
     PincGraphicsApi_opengl,
+    /// @brief No graphics api, the application writes pixels into the window's framebuffer itself. See pincWindowGetPixels.
+    ///        Only the none window backend supports this.
+    PincGraphicsApi_raw,
 } PincGraphicsApiEnum;
 
 typedef uint32_t PincGraphicsApi;
 
+/// @brief The phases of getting from nothing to the first frame on screen, for pincQueryStartupTimings.
+typedef enum {
+    /// @brief All of pincInitIncomplete. With pincInitIncompleteAsync, the loading on the other thread and the rest in pincInitWait or pincInitPoll, but not the time in between.
+    PincStartupPhase_initIncomplete = 0,
+    /// @brief Loading the window backend's library and its functions. Part of pincInitIncomplete.
+    PincStartupPhase_libraryLoad,
+    /// @brief Initializing the window backend's library, after it's loaded. Part of pincInitIncomplete.
+    PincStartupPhase_backendInit,
+    /// @brief Finding the framebuffer formats. Part of whatever needed them first, usually pincInitComplete.
+    PincStartupPhase_framebufferFormats,
+    /// @brief All of pincInitComplete
+    PincStartupPhase_initComplete,
+    /// @brief Creating the first window
+    PincStartupPhase_windowComplete,
+    /// @brief Creating the first OpenGL context
+    PincStartupPhase_openglContextComplete,
+    /// @brief The first pincWindowPresentFramebuffer
+    PincStartupPhase_firstPresent,
+    /// @brief From the start of pincInitIncomplete to the end of the first pincWindowPresentFramebuffer
+    PincStartupPhase_timeToFirstFrame,
+    PincStartupPhase_count,
+} PincStartupPhaseEnum;
+
+typedef uint32_t PincStartupPhase;
+
+/// @brief Kinds of events the none window backend can generate by itself each step, see pincHeadlessSetSyntheticEvents
+typedef enum {
+    /// @brief Cursor moves within a window, walking along its diagonal
+    PincHeadlessSynthetic_cursorMove = 0,
+    /// @brief Key repeats of the space key
+    PincHeadlessSynthetic_keyRepeat,
+    /// @brief Resizes of a window, alternating between its size and one pixel larger in each direction
+    PincHeadlessSynthetic_resize,
+    /// @brief Text input of lowercase latin letters
+    PincHeadlessSynthetic_textInput,
+    PincHeadlessSynthetic_count,
+} PincHeadlessSyntheticEnum;
+
+typedef uint32_t PincHeadlessSynthetic;
+
 typedef enum {
     PincErrorCode_pass = 0,
     PincErrorCode_external,
@@ -304,6 +347,25 @@ typedef enum {
 
 typedef uint32_t PincMediaType;
 
+/// @brief Categories of memory that Pinc allocates, for routing each one to a different set of allocation callbacks.
+///        See pincPreinitSetCategoryAllocCallbacks.
+typedef enum {
+    /// Backing blocks of the temporary arenas. These are large (multiples of 4KiB) and are mostly kept around between steps.
+    PincAllocCategory_tempArena = 0,
+    /// Object pools. These live as long as the objects do, and grow as more objects are created.
+    PincAllocCategory_objectPool,
+    /// Event buffers. These are two buffers that grow to fit the largest number of events in a single step.
+    PincAllocCategory_eventBuffer,
+    /// Long lived strings, like window titles.
+    PincAllocCategory_string,
+    /// Everything that a window backend allocates for its own internal state.
+    PincAllocCategory_backend,
+    /// This is for convenience
+    PincAllocCategory_count,
+} PincAllocCategoryEnum;
+
+typedef uint32_t PincAllocCategory;
+
 /// @section window state enums
 
 typedef enum {
@@ -365,31 +427,110 @@ PINC_EXTERN void PINC_CALL pincPreinitSetErrorCallback(PincErrorCallback callbac
 PINC_EXTERN PincErrorCode PINC_CALL pincLastErrorCode(void);
 
 /// Null terminated and with a returned length
+/// The message is only put together when it's asked for (or when it's given to the error callback).
 /// Allocated on the temp allocator, which means two things:
-/// - the last error message must be cleared on pinc_step()
-/// - the caller must not keep the returned pointer between pinc steps
+/// - the last error message is cleared on pincStep()
+/// - the returned pointer stays valid until the second call to pincStep() after the error, and must not be kept any longer than that
 /// The message may have multiple lines if there is additional information from down the callstack between the user and where the error occurred.
 PINC_EXTERN char const* PINC_CALL pincLastErrorMessage(size_t* out_len);
 
 /// If the last error was recoverable, it's as if the function call resulting in the error had no effect.
 PINC_EXTERN bool PINC_CALL pincLastErrorRecoverable(void);
 
+/// Identical errors within one step are only reported (to the error callback or stdout) the first time, the rest are just counted.
+/// This is how many more times the last error happened after that. The counts for the step are logged on pincStep().
+PINC_EXTERN uint32_t PINC_CALL pincLastErrorRepeatCount(void);
+
 /// @brief Set optional allocation callbacks. Must be called before incomplete_init, or never. The type of each proc has more information. They either must all be set, or all null.
 PINC_EXTERN void PINC_CALL pincPreinitSetAllocCallbacks(void* user_ptr, PincAllocCallback alloc, PincReallocCallback realloc, PincFreeCallback free);
 
+/// @brief Set optional allocation callbacks for a single category of memory. Must be called before incomplete_init, or never.
+///        Categories without their own callbacks use the ones from pincPreinitSetAllocCallbacks, or the default platform allocator if those are not set either.
+///        Like pincPreinitSetAllocCallbacks, the callbacks must either all be set, or all null to go back to the default.
+/// @param category The category of memory to route to these callbacks
+PINC_EXTERN void PINC_CALL pincPreinitSetCategoryAllocCallbacks(PincAllocCategory category, void* user_ptr, PincAllocCallback alloc, PincReallocCallback realloc, PincFreeCallback free);
+
 /// Sets the log optional log callback. May be set to null for default platform-specific behavior. The string given to the log function is guaranteed to be null terminated but is given a length for convenience.
+/// Messages below the error level are buffered, and written out in pincStep, at the end of init, in pincDeinit, when an error is logged, or when the buffer is mostly full.
+/// Buffered messages are lost if the process ends without getting to one of those (for example a crash, or calling exit() without pincDeinit).
 PINC_EXTERN void PINC_CALL pincPreinitSetLogCallback(void* user_ptr, PincLogCallback log);
 
+/// @brief Turn on the capability cache, which keeps what the window backend reports (like framebuffer formats and OpenGL support) in a file so later runs don't have to probe for it again.
+///        The cache is keyed on the window backend, its library version, and the display configuration, so it's redone on its own when any of those change.
+///        The file is written after the first successful framebuffer format probe, and in pincDeinit if any OpenGL support was probed that the file doesn't have. Failing to read or write it is not an error, Pinc just probes like it would without the cache.
+/// @param path where to keep the cache file. If path_len is zero, path is assumed to be null terminated, or itself null to turn the cache back off.
+/// @param path_len the length of path, at most 512 bytes.
+PINC_EXTERN void PINC_CALL pincPreinitSetCapabilityCachePath(char const* path, uint32_t path_len);
+
+/// @brief Delete the capability cache file, so the next init probes everything again.
+///        What was already loaded in this session stays as it is. Does nothing if there is no cache path set.
+PINC_EXTERN void PINC_CALL pincCapabilityCacheInvalidate(void);
+
+/// @subsection instances
+// Everything Pinc has (allocators, objects, events, errors, settings) belongs to an instance. Normally there is just the one default instance,
+// but more can be created for things like test shards or plugins that shouldn't know about each other.
+// Each thread has a current instance that all other Pinc functions use, which starts out as the default one.
+// That includes threads the application makes itself, so they have to make an instance current before using it.
+// If Pinc was built with a compiler that has no thread locals, there is only one current instance, shared by every thread in the process.
+// The window backend's library is shared between instances - SDL2 is only loaded once per process no matter how many instances load it,
+// and it has one event queue and one current OpenGL context per thread for the whole process. Pinc sorts out which window events belong to which instance,
+// but events without a window (keyboard, mouse buttons, text, clipboard) go to whichever instance steps first.
+// SDL2 also wants all of its windows on the main thread, so instances that open windows should all be used from the main thread.
+// Threads that called pincTempThreadInit are tied to the instance that was current at the time.
+
+/// @brief An isolated Pinc instance.
+typedef struct PincInstance PincInstance;
+
+/// @brief Create a new instance in the preinit state. It does not become current, see pincInstanceMakeCurrent.
+///        This is allocated directly from the platform, since the allocation callbacks are part of the instance.
+/// @return the new instance, or null if it could not be allocated.
+PINC_EXTERN PincInstance* PINC_CALL pincInstanceCreate(void);
+
+/// @brief Deinitialize an instance (as in pincDeinit) and free it. If it was current on this thread, the default instance becomes current.
+PINC_EXTERN void PINC_CALL pincInstanceDestroy(PincInstance* instance);
+
+/// @brief Make an instance current on the calling thread. Null is the default instance.
+PINC_EXTERN void PINC_CALL pincInstanceMakeCurrent(PincInstance* instance);
+
+/// @brief Get the calling thread's current instance, or null if it is the default one.
+PINC_EXTERN PincInstance* PINC_CALL pincInstanceGetCurrent(void);
+
+/// @brief Keep the window backend loaded through pincDeinit, so the next initialization can skip loading and initializing it again.
+///        With this on, pincDeinit still destroys every object and resets everything else, but keeps the backend's library, its initialized state,
+///        and the framebuffer formats (and anything else it found out about the system) for the next init. This is meant for test suites and tools that reset Pinc over and over.
+///        What is retained is only used again if the next initialization has the same allocation callbacks, otherwise it is freed and loaded again from scratch.
+///        Can be called at any time. To release everything, turn this off and call pincDeinit (even in preinit), or destroy the instance.
+PINC_EXTERN void PINC_CALL pincSetRetainBackend(bool retain);
+
 /// @brief Begin the initialization process
 /// @return the success or failure of this function call. Failures are likely caused by external factors (ex: no window backends) or a failed allocation.
 PINC_EXTERN void PINC_CALL pincInitIncomplete(void);
 
+/// @brief Begin the initialization process, but load the window backend (the slowest part of pincInitIncomplete) on another thread so the application can do other things in the meantime.
+///        Until pincInitPoll returns true or pincInitWait returns, the only Pinc functions that can be called are pincInitPoll, pincInitWait, and pincDeinit.
+///        The rest of initialization, the part that needs the main thread, happens in whichever of those finishes it - so they must be called from the same thread as this one.
+///        Errors while loading may be reported to the error callback from the loading thread. If allocation callbacks are set, they may be called from the loading thread too.
+///        So may the log callback, although never from both threads at once.
+///        If there are no threads on this platform, or Pinc was built without thread locals, this does all of pincInitIncomplete right away.
+PINC_EXTERN void PINC_CALL pincInitIncompleteAsync(void);
+
+/// @brief Check whether pincInitIncompleteAsync is done, and finish initialization if it is. Never blocks for long.
+/// @return true once initialization is as far along as pincInitIncomplete would have it, or has failed (check pincLastErrorCode).
+///         Also true if pincInitIncompleteAsync was not called, as long as Pinc is past preinit.
+PINC_EXTERN bool PINC_CALL pincInitPoll(void);
+
+/// @brief Wait for pincInitIncompleteAsync to be done, then finish initialization. Does nothing if pincInitIncompleteAsync is not in progress.
+///        pincInitComplete calls this itself, so it's only needed for calling functions in between the two.
+PINC_EXTERN void PINC_CALL pincInitWait(void);
+
 /// @subsection full initialization functions
 /// @brief The query functions work after initialization, although most of them are useless after the fact
 
 PINC_EXTERN bool PINC_CALL pincQueryWindowBackendSupport(PincWindowBackend window_backend);
 
 /// @brief Query the default window backend for this system.
+///        This is never PincWindowBackend_none, since an application that wants to be headless has to say so.
+///        If no other backend is available, this is an external error.
 /// @return The default window backend.
 PINC_EXTERN PincWindowBackend PINC_CALL pincQueryWindowBackendDefault(void);
 
@@ -428,6 +569,15 @@ PINC_EXTERN uint32_t PINC_CALL pincQueryFramebufferFormatChannelBits(PincFramebu
 
 PINC_EXTERN PincColorSpace PINC_CALL pincQueryFramebufferFormatColorSpace(PincFramebufferFormatHandle format_handle);
 
+/// @brief Make a framebuffer format directly, without querying which ones the window backend has.
+///        Passing this to pincInitComplete skips enumerating framebuffer formats entirely, which can take a while on systems with many displays or display modes.
+///        The window backend will get as close to it as it can. It is not listed by pincQueryFramebufferFormats.
+/// @param channels the number of channels, from 1 to 4.
+/// @param channel_bits the number of bits in each channel, from 1 to 32, with one entry per channel.
+/// @param color_space the color space of the format.
+/// @return the new framebuffer format, or 0 if any of the parameters are out of range.
+PINC_EXTERN PincFramebufferFormatHandle PINC_CALL pincFramebufferFormatCreate(uint32_t channels, uint32_t const* channel_bits, PincColorSpace color_space);
+
 // Many platforms (web & most consoles) can only have a certain number of windows open at a time. Most of the time this is one,
 // but it's possible to set up a web template with multiple canvases and there are consoles with 2 screens (like the nintendo DS) where it makes sense to treat them as separate windows.
 // Returns 0 if there is no reasonable limit (the limit is not a specific number, and you'll probably never encounter related issues in this case)
@@ -440,6 +590,13 @@ PINC_EXTERN void PINC_CALL pincInitComplete(PincWindowBackend window_backend, Pi
 
 PINC_EXTERN void PINC_CALL pincDeinit(void);
 
+/// @brief Deinitialize Pinc for a process that is about to exit. OpenGL contexts, windows, and the window backend are destroyed (so they disappear right away),
+///        but nothing goes through the usual per-object validation and none of Pinc's memory is freed - the OS gets it all back when the process exits anyway.
+///        Like pincDeinit this can be called at any point, and Pinc can be initialized again afterwards, but everything it had allocated is leaked.
+///        Anything kept by pincSetRetainBackend is leaked as well, other than a retained backend being shut down like any other.
+///        Only the current instance is deinitialized. Other instances keep working, even when they share the window backend's library.
+PINC_EXTERN void PINC_CALL pincDeinitFast(void);
+
 PINC_EXTERN PincWindowBackend PINC_CALL pincQuerySetWindowBackend(void);
 
 PINC_EXTERN PincGraphicsApi PINC_CALL pincQuerySetGraphicsApi(void);
@@ -602,10 +759,136 @@ PINC_EXTERN bool PINC_CALL pincGetVsync(void);
 /// @param complete_window_handle the window whose framebuffer to present.
 PINC_EXTERN void PINC_CALL pincWindowPresentFramebuffer(PincWindowHandle complete_window_handle);
 
+/// @brief Get the pixels of a window's back buffer, for the raw graphics api. Draw into these, then present them with pincWindowPresentFramebuffer.
+///        Each pixel is the framebuffer format's channels in order, each channel taking the fewest whole bytes that fit its bits.
+/// @param complete_window_handle the window. Asserts the object is valid, and is a window.
+/// @param out_stride set to the number of bytes from the start of one row to the start of the next
+/// @return The top left pixel, or null if the window has no pixels (it's 0 pixels wide or tall). Valid until the window is presented, resized, or destroyed.
+PINC_EXTERN void* PINC_CALL pincWindowGetPixels(PincWindowHandle complete_window_handle, uint32_t* out_stride);
+
+/// @brief Copy the last frame presented to a window into dest, for the raw graphics api.
+///        Rows are width times the pixel size bytes long (see pincWindowGetPixels), and dest must have room for the window's height of them.
+/// @param complete_window_handle the window. Asserts the object is valid, and is a window.
+/// @param dest where to copy the pixels
+/// @param dest_stride the number of bytes from the start of one row in dest to the start of the next
+PINC_EXTERN void PINC_CALL pincWindowReadPixels(PincWindowHandle complete_window_handle, void* dest, uint32_t dest_stride);
+
+/// @section headless
+
+// With PincWindowBackend_none there is no user and no OS to make events, so the application (or its tests) makes them instead.
+// Each one shows up after the next pincStep, the same as real events do. It is a user error to call these with any other window backend.
+
+PINC_EXTERN void PINC_CALL pincHeadlessInjectCloseSignal(PincWindowHandle window);
+
+/// @brief Resize a window as if the user did it. This reallocates its pixels, so the contents are cleared and pointers from pincWindowGetPixels are invalidated.
+PINC_EXTERN void PINC_CALL pincHeadlessInjectResize(PincWindowHandle window, uint32_t width, uint32_t height);
+
+/// @brief Give a window focus, or take focus from every window with 0
+PINC_EXTERN void PINC_CALL pincHeadlessInjectFocus(PincWindowHandle window);
+
+/// @param state The new state of the mouse buttons, in the same bitfield as pincEventMouseButtonState
+PINC_EXTERN void PINC_CALL pincHeadlessInjectMouseButton(uint32_t state);
+
+/// @brief Move the cursor to a point in a window. This is a cursor transition event if it was last in a different window (or none), and a cursor move otherwise.
+PINC_EXTERN void PINC_CALL pincHeadlessInjectCursorMove(PincWindowHandle window, uint32_t x, uint32_t y);
+
+PINC_EXTERN void PINC_CALL pincHeadlessInjectKeyboardButton(PincKeyboardKey key, bool state, bool repeat);
+
+PINC_EXTERN void PINC_CALL pincHeadlessInjectTextInput(uint32_t codepoint);
+
+PINC_EXTERN void PINC_CALL pincHeadlessInjectScroll(float vertical, float horizontal);
+
+/// @brief Have the none backend generate a stream of events by itself during every pincStep, for load testing the event path without an OS in the way.
+///        The events are made the same way injected events are, and they show up in the step they were generated in rather than the next one.
+///        Each kind has its own stream, set independently. The stream stops if its window is closed.
+/// @param kind The kind of event to generate
+/// @param window The window the events are for. Ignored for kinds that don't have a window. May be 0 when per_step is 0.
+/// @param per_step How many events of this kind to generate each step, or 0 to stop generating them
+PINC_EXTERN void PINC_CALL pincHeadlessSetSyntheticEvents(PincHeadlessSynthetic kind, PincWindowHandle window, uint32_t per_step);
+
 /// @section user IO
 
 // Clipboard, the general results of events (cursor position, current window, keyboard state, etc), other window / application IO
 
+/// @section temporary allocations
+
+/// @brief Allocate memory on Pinc's per-step temporary arena. This is the same arena Pinc uses internally for its own temporary data.
+///        The temporary arena is double buffered: memory allocated before a call to pincStep() stays valid until the call to pincStep() after that one,
+///        at which point it is reclaimed all at once - there is no free function.
+///        Valid between pincInitIncomplete and pincDeinit.
+/// @param size Number of bytes to allocate.
+/// @param alignment Alignment of the returned pointer. Must be a power of 2, or 0 for an alignment suitable for any fundamental type.
+/// @return A pointer to the memory. Never null unless an error occurred.
+PINC_EXTERN void* PINC_CALL pincTempAlloc(size_t size, size_t alignment);
+
+/// @brief Get the number of bytes currently allocated on the temporary arena since the last pincStep(), including Pinc's own allocations and alignment padding.
+PINC_EXTERN size_t PINC_CALL pincTempAllocUsage(void);
+
+/// @section steady state
+
+// Once an application has warmed up (windows are open, event buffers and temporary arenas have grown to fit), a loop of pincStep, event handling and present
+// should not need to allocate any memory from the root allocator (the allocation callbacks). These functions help make sure that is the case.
+
+/// @brief Enter steady state mode. From now on, any root allocation raises a recoverable user error saying which category of memory was allocated.
+///        The allocation itself still happens, so this is purely diagnostic. Lasts until pincClearSteadyState or pincDeinit.
+PINC_EXTERN void PINC_CALL pincMarkSteadyState(void);
+
+/// @brief Leave steady state mode, for when the application is about to do something that is expected to allocate (like opening a window).
+PINC_EXTERN void PINC_CALL pincClearSteadyState(void);
+
+/// @brief Get the number of root allocations (including reallocations, from any category) during the previous step - that is, between the last two calls to pincStep.
+///        Temporary arenas of threads that called pincTempThreadInit are not counted, and don't trigger steady state errors either.
+PINC_EXTERN uint32_t PINC_CALL pincQueryStepRootAllocations(void);
+
+/// @section startup timings
+
+/// @brief Get how long each phase of startup took, in nanoseconds. Only the first time each phase happens is counted, so opening more windows later changes nothing.
+///        Phases that have not happened (yet) are 0. The timings are reset by pincDeinit.
+/// @param nanos_dest a buffer to output the timings, indexed by PincStartupPhase, or null to just query the number of phases.
+/// @param capacity the number of elements in nanos_dest
+/// @return the number of phases, which is PincStartupPhase_count for this version of Pinc
+PINC_EXTERN uint32_t PINC_CALL pincQueryStartupTimings(int64_t* nanos_dest, uint32_t capacity);
+
+/// @section frame pacing
+
+// For capping the frame rate without vsync. Vsync is still the better option when it's available, but it isn't always (or the desired rate is different from the display's).
+// The pacer sleeps for most of the frame and spins for the last fraction of a millisecond, so frames land on time without keeping a core busy.
+// Deadlines are spaced exactly one period apart instead of one period after the last wait, so an oversleep on one frame is made up on the next rather than accumulating.
+// These can be used at any time, even before pincInitIncomplete. pincDeinit resets the pacer.
+
+/// @brief Set the target time between frames, in nanoseconds. 0 disables pacing (the default), in which case pincFramePacerWait only measures frame times.
+PINC_EXTERN void PINC_CALL pincFramePacerSetPeriodNanos(int64_t period_nanos);
+
+/// @brief Wait until it is time for the next frame. Call this once per frame, generally right before pincWindowPresentFramebuffer.
+///        If the application falls more than a whole period behind, the pacer starts over from the current time instead of rushing to catch up.
+PINC_EXTERN void PINC_CALL pincFramePacerWait(void);
+
+/// @brief Get the time between the last two calls to pincFramePacerWait, in nanoseconds. 0 if it has not been called twice yet.
+PINC_EXTERN int64_t PINC_CALL pincFramePacerQueryFrameTimeNanos(void);
+
+/// @brief Get the measured frame time jitter, in nanoseconds. This is how far off frame times are from the target period (or from the previous frame time when not pacing),
+///        smoothed over roughly the last 16 frames.
+PINC_EXTERN int64_t PINC_CALL pincFramePacerQueryJitterNanos(void);
+
+// Pinc's API is generally not thread safe, however the temporary arena is used by practically everything (including errors and logging).
+// A thread other than the one that called pincInitIncomplete can get its own temporary arenas, so it never touches the main ones.
+// Once a thread has called pincTempThreadInit, all of Pinc's temporary allocations from that thread (including pincTempAlloc) use its own arenas with no locking.
+// If allocation callbacks are set, they must be thread safe for these to be used.
+
+/// @brief Create temporary arenas for the calling thread. Must not be called on the thread that called pincInitIncomplete.
+///        The arenas are allocated with the tempArena category's callbacks as they are at the time of this call.
+/// @return True if the thread now has its own arenas. Errors can't be reported from other threads, so this returns false without an error
+///         if Pinc isn't initialized or the thread already has its own arenas.
+///         If the compiler Pinc was built with has no thread locals, this always fails with an external error, and every thread keeps using the main arenas.
+PINC_EXTERN bool PINC_CALL pincTempThreadInit(void);
+
+/// @brief The pincStep() equivalent for the calling thread's temporary arenas. Memory lifetime follows the same double buffered rules as pincTempAlloc.
+PINC_EXTERN void PINC_CALL pincTempThreadStep(void);
+
+/// @brief Free the calling thread's temporary arenas. Every thread that called pincTempThreadInit must call this before it exits.
+///        The arenas are freed with the callbacks they were allocated with, so this may be called after pincDeinit as long as those callbacks are still valid.
+PINC_EXTERN void PINC_CALL pincTempThreadDeinit(void);
+
 /// @section main loop & events
 
 /// @brief Flushes internal buffers and collects user input
@@ -711,8 +994,9 @@ PINC_EXTERN float PINC_CALL pincEventScrollHorizontal(uint32_t event_index);
 
 PINC_EXTERN PincMediaType PINC_CALL pincEventClipboardChangedMediaType(uint32_t event_index);
 
-/// For the sake of convenience, this is null terminated. The memory containing this data is reused upon calling pincStep(),
-/// so be careful to either finish using the memory before the next call to pincStep, or make a copy.
+/// For the sake of convenience, this is null terminated. The memory containing this data is on the temporary arena (see pincTempAlloc),
+/// so it remains valid through the next call to pincStep() and is reused upon the call after that.
+/// This means events can be processed a step late without copying the data, but anything longer than that needs a copy.
 /// Please note that this data might not be text, and the data itself can contain null words before the null terminator.
 /// See pincEventClipboardChangedMediaType, and pincEventClipboardChangedDataSize for more information.
 PINC_EXTERN char const* PINC_CALL pincEventClipboardChangedData(uint32_t event_index);
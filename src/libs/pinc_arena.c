@@ -31,6 +31,8 @@ static void guaranteeCapacity(PincArenaAllocator* this, size_t cap) {
             }
             block->next = this->blocks;
             this->blocks = block;
+            this->retiredUsed += this->lastBlockUsed;
+            this->lastBlockUsed = 0;
             return;
         }
         prevBlock = block;
@@ -45,6 +47,8 @@ static void guaranteeCapacity(PincArenaAllocator* this, size_t cap) {
     newBlock->data = capWithOverhead;
     newBlock->next = this->blocks;
     this->blocks = newBlock;
+    this->retiredUsed += this->lastBlockUsed;
+    this->lastBlockUsed = 0;
 }
 
 void PincArenaAllocator_init(PincArenaAllocator* this, PincAllocator back, size_t initialCapacity, size_t blockSize) {
@@ -53,6 +57,7 @@ void PincArenaAllocator_init(PincArenaAllocator* this, PincAllocator back, size_
     this->blocks = 0;
     this->emptyBlocks = 0;
     this->lastBlockUsed = 0;
+    this->retiredUsed = 0;
 
     guaranteeCapacity(this, initialCapacity);
 }
@@ -67,7 +72,8 @@ void* PincArenaAllocator_allocate(void* thisUncast, size_t size) {
 
 void* PincArenaAllocator_allocateAligned(void* thisUncast, size_t size, size_t alignment) {
     PincArenaAllocator* this = (PincArenaAllocator*)thisUncast;
-    guaranteeCapacity(this, size);
+    // Worst case the alignment eats alignment-1 bytes at the front
+    guaranteeCapacity(this, size + alignment - 1);
     // guaranteeCapacity puts the space on the top of the stack so we can just yoink some out willy nilly
     char* blockStart = (char*)this->blocks;
     uintptr_t firstFreeSpot = (uintptr_t) (blockStart + sizeof(PincArenaAllocatorBlock) + this->lastBlockUsed);
@@ -87,7 +93,7 @@ void* PincArenaAllocator_reallocate(void* thisUncast, void* ptr, size_t size, si
     if(((char*)ptr) + size == ((char*)this->blocks + sizeof(PincArenaAllocatorBlock) + this->lastBlockUsed)) {
         // Check that there is enough additional space
         if(this->blocks->data - sizeof(PincArenaAllocatorBlock) - this->lastBlockUsed >= extraSpaceNeeded) {
-            this->lastBlockUsed -= extraSpaceNeeded;
+            this->lastBlockUsed += extraSpaceNeeded;
             return ptr;
         }
     }
@@ -117,6 +123,7 @@ void PincArenaAllocator_reset(PincArenaAllocator* this, size_t keep) { //NOLINT:
     }
     this->blocks = 0;
     this->lastBlockUsed = 0;
+    this->retiredUsed = 0;
 
     // Bucket sort (theoretically) works well here since blocks are always going to be an integer number of the block size
     // And there should be a good distribution of mostly smaller blocks with a few much larger ones,
@@ -234,4 +241,9 @@ void PincArenaAllocator_deinit(PincArenaAllocator* this) {
     this->blocks = 0;
     this->emptyBlocks = 0;
     this->lastBlockUsed = 0;
+    this->retiredUsed = 0;
+}
+
+size_t PincArenaAllocator_usage(PincArenaAllocator* this) {
+    return this->retiredUsed + this->lastBlockUsed;
 }
@@ -37,6 +37,9 @@ typedef struct {
     // So instead of storing the used amount for each block, we store it once for the 'surface' or 'top' block that we allocate from.
     // It does not include the space taken up by the block struct itself.
     size_t lastBlockUsed;
+    // Sum of lastBlockUsed of every block that got buried under a newer block since the last reset.
+    // Only exists so usage() doesn't need to walk the block list.
+    size_t retiredUsed;
 } PincArenaAllocator;
 
 void PincArenaAllocator_init(PincArenaAllocator* this, PincAllocator back, size_t initialCapacity, size_t blockSize);
@@ -55,4 +58,8 @@ void PincArenaAllocator_reset(PincArenaAllocator* this, size_t keep);
 
 void PincArenaAllocator_deinit(PincArenaAllocator* this);
 
+/// Number of bytes handed out since the last reset, including alignment padding.
+/// Bytes given back with free() are only subtracted if they were on the top of the stack.
+size_t PincArenaAllocator_usage(PincArenaAllocator* this);
+
 #endif
\ No newline at end of file
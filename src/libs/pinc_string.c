@@ -62,6 +62,27 @@ PincString pincString_slice(PincString str, size_t start, size_t len) {
     };
 }
 
+uint64_t pincString_hash(PincString str) {
+    uint64_t hash = 14695981039346656037ULL;
+    for(size_t i=0; i<str.len; ++i) {
+        hash ^= str.str[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+bool pincString_equal(PincString a, PincString b) {
+    if(a.len != b.len) {
+        return false;
+    }
+    for(size_t i=0; i<a.len; ++i) {
+        if(a.str[i] != b.str[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
 void pincString_free(PincString* str, PincAllocator alloc) {
     PincAllocator_free(alloc, str->str, str->len);
     str->str = 0;
@@ -32,6 +32,12 @@ PincString pincString_slice(PincString str, size_t start, size_t len);
 
 void pincString_free(PincString* str, PincAllocator alloc);
 
+/// FNV-1a hash of a string. Not cryptographic, just enough to tell strings apart cheaply.
+uint64_t pincString_hash(PincString str);
+
+/// Whether two strings have the same bytes
+bool pincString_equal(PincString a, PincString b);
+
 /// @brief Concatenate multiple strings together
 /// @param numStrings the number of strings in the array to concatenate together 
 /// @param strings the strings to concatenate
@@ -1,4 +1,5 @@
 #include "pinc_utf8.h"
+#include "platform/pinc_cpu.h"
 
 // Implementation based on Zig's standard library: 0.14.1 -> unicode.zig.
 // Seriously, Zig's standard library is a genuine gold mine for random things like this.
@@ -43,17 +44,10 @@ bool pincValidateUTF8String(char const* str_ptr, size_t str_len) { //NOLINT
     uint8_t const* rem_ptr = (uint8_t const*)str_ptr;
     size_t rem_len = str_len;
 
-    // Skip any ASCII stuff at the start
-    // Zig uses a vectorized loop... using intrinsics sounds like a pain,
-    // so hopefully the compiler can figure it out.
-    while(rem_len > 0) {
-        uint8_t const value = rem_ptr[0];
-        if((value & (uint8_t)0x80) != 0) {
-            break;
-        }
-        rem_ptr = &(rem_ptr[1]);
-        rem_len -= 1;
-    }
+    // Skip any ASCII stuff at the start, with a vectorized kernel like Zig does (see platform/pinc_cpu.h)
+    size_t const ascii_len = pincCpuKernels()->asciiPrefixLen(rem_ptr, rem_len);
+    rem_ptr = &(rem_ptr[ascii_len]);
+    rem_len -= ascii_len;
 
     // const min_continue = (uint8_t)0b10000000; // PSYCH, no binary literals in C (on some compilers)
     uint8_t const min_continue = (uint8_t)0x80;
@@ -184,6 +178,19 @@ size_t pincDecodeUTF8String(char const* str_ptr, size_t str_len, uint32_t* out_p
 
     size_t index = 0;
     while(rem_len > 0) {
+        if(rem_str[0] < 0x80) {
+            // A run of ASCII decodes to itself, no need to go through the full decoder one byte at a time
+            size_t const ascii_len = pincCpuKernels()->asciiPrefixLen(rem_str, rem_len);
+            for(size_t i=0; i<ascii_len; ++i) {
+                if(out_ptr && index < out_capacity) {
+                    out_ptr[index] = rem_str[i];
+                }
+                index += 1;
+            }
+            rem_str = &(rem_str[ascii_len]);
+            rem_len -= ascii_len;
+            continue;
+        }
         size_t len = pincUTF8SequenceLen(rem_str[0]);
 
         if(out_ptr && index < out_capacity) {
@@ -0,0 +1,156 @@
+#include "pinc_capability_cache.h"
+#include "libs/pinc_string.h"
+#include "pinc_log.h"
+#include "pinc_main.h"
+#include "platform/pinc_platform.h"
+
+// "PCAP" when read as bytes
+#define PINC_CAPABILITY_CACHE_MAGIC 0x50414350u
+// Bump this whenever the layout changes, so old caches are thrown out instead of misread
+#define PINC_CAPABILITY_CACHE_VERSION 2u
+
+#define PINC_CAPABILITY_CACHE_HEADER_SIZE (4 * sizeof(uint32_t) + sizeof(uint64_t))
+#define PINC_CAPABILITY_CACHE_GL_PROBE_SIZE ((1 + PINC_GL_PROBE_RESULTS_CAPACITY) * sizeof(uint32_t))
+#define PINC_CAPABILITY_CACHE_FORMAT_SIZE (6 * sizeof(uint32_t))
+
+static P_INLINE uint32_t pincCapabilityCacheReadU32(uint8_t const* data, size_t* offset) {
+    uint32_t value;
+    pincMemCopy(data + *offset, &value, sizeof(value));
+    *offset += sizeof(value);
+    return value;
+}
+
+static P_INLINE uint64_t pincCapabilityCacheReadU64(uint8_t const* data, size_t* offset) {
+    uint64_t value;
+    pincMemCopy(data + *offset, &value, sizeof(value));
+    *offset += sizeof(value);
+    return value;
+}
+
+static P_INLINE void pincCapabilityCacheWriteU32(uint8_t* data, size_t* offset, uint32_t value) {
+    pincMemCopy(&value, data + *offset, sizeof(value));
+    *offset += sizeof(value);
+}
+
+static P_INLINE void pincCapabilityCacheWriteU64(uint8_t* data, size_t* offset, uint64_t value) {
+    pincMemCopy(&value, data + *offset, sizeof(value));
+    *offset += sizeof(value);
+}
+
+bool pincCapabilityCacheLoad(PincCapabilityCache* out, PincWindowBackend backend, uint64_t configurationHash, PincAllocator allocator) {
+    if(staticState.capabilityCachePathLen == 0) {
+        return false;
+    }
+    // The header alone says whether the rest is worth reading
+    uint8_t header[PINC_CAPABILITY_CACHE_HEADER_SIZE];
+    size_t fileSize = 0;
+    if(!pincFileRead((uint8_t const*)staticState.capabilityCachePath, staticState.capabilityCachePathLen, header, sizeof(header), &fileSize)) {
+        return false;
+    }
+    if(fileSize < sizeof(header) + sizeof(uint64_t)) {
+        return false;
+    }
+    size_t offset = 0;
+    uint32_t magic = pincCapabilityCacheReadU32(header, &offset);
+    uint32_t version = pincCapabilityCacheReadU32(header, &offset);
+    uint32_t fileBackend = pincCapabilityCacheReadU32(header, &offset);
+    uint32_t formatsNum = pincCapabilityCacheReadU32(header, &offset);
+    uint64_t fileConfigurationHash = pincCapabilityCacheReadU64(header, &offset);
+    if(magic != PINC_CAPABILITY_CACHE_MAGIC || version != PINC_CAPABILITY_CACHE_VERSION || fileBackend != (uint32_t)backend || fileConfigurationHash != configurationHash) {
+        PincLogLiteral(PincLogLevel_debug, "[FRONTEND] [TRACE] Capability cache is stale, probing again");
+        return false;
+    }
+    size_t expectedSize = sizeof(header) + PINC_CAPABILITY_CACHE_GL_PROBE_SIZE + (size_t)formatsNum * PINC_CAPABILITY_CACHE_FORMAT_SIZE + sizeof(uint64_t);
+    if(fileSize != expectedSize) {
+        return false;
+    }
+    uint8_t* data = PincAllocator_allocate(tempAllocator, fileSize);
+    size_t readSize = 0;
+    if(!pincFileRead((uint8_t const*)staticState.capabilityCachePath, staticState.capabilityCachePathLen, data, fileSize, &readSize) || readSize != fileSize) {
+        PincAllocator_free(tempAllocator, data, fileSize);
+        return false;
+    }
+    // The file could have been replaced between the two reads, so this checks the whole thing including the header again
+    size_t checksumOffset = fileSize - sizeof(uint64_t);
+    uint64_t checksum = pincCapabilityCacheReadU64(data, &checksumOffset);
+    bool headerSame = true;
+    for(size_t i=0; i<sizeof(header); ++i) {
+        headerSame = headerSame && data[i] == header[i];
+    }
+    if(!headerSame || checksum != pincString_hash((PincString){data, fileSize - sizeof(uint64_t)})) {
+        PincAllocator_free(tempAllocator, data, fileSize);
+        return false;
+    }
+    *out = (PincCapabilityCache){
+        .backend = backend,
+        .configurationHash = configurationHash,
+        .framebufferFormats = formatsNum ? PincAllocator_allocate(allocator, formatsNum * sizeof(FramebufferFormat)) : 0,
+        .framebufferFormatsNum = formatsNum,
+    };
+    offset = sizeof(header);
+    out->glProbe.probed = pincCapabilityCacheReadU32(data, &offset);
+    for(uint32_t i=0; i<PINC_GL_PROBE_RESULTS_CAPACITY; ++i) {
+        out->glProbe.results[i] = (int32_t)pincCapabilityCacheReadU32(data, &offset);
+    }
+    for(uint32_t i=0; i<formatsNum; ++i) {
+        FramebufferFormat* format = &out->framebufferFormats[i];
+        format->channels = pincCapabilityCacheReadU32(data, &offset);
+        for(uint32_t channel=0; channel<4; ++channel) {
+            format->channel_bits[channel] = pincCapabilityCacheReadU32(data, &offset);
+        }
+        format->color_space = (PincColorSpace)pincCapabilityCacheReadU32(data, &offset);
+    }
+    PincAllocator_free(tempAllocator, data, fileSize);
+    PincLogLiteral(PincLogLevel_debug, "[FRONTEND] [TRACE] Loaded capabilities from the capability cache");
+    return true;
+}
+
+void pincCapabilityCacheStore(PincCapabilityCache const* cache) {
+    if(staticState.capabilityCachePathLen == 0) {
+        return;
+    }
+    size_t size = PINC_CAPABILITY_CACHE_HEADER_SIZE + PINC_CAPABILITY_CACHE_GL_PROBE_SIZE + (size_t)cache->framebufferFormatsNum * PINC_CAPABILITY_CACHE_FORMAT_SIZE + sizeof(uint64_t);
+    uint8_t* data = PincAllocator_allocate(tempAllocator, size);
+    size_t offset = 0;
+    pincCapabilityCacheWriteU32(data, &offset, PINC_CAPABILITY_CACHE_MAGIC);
+    pincCapabilityCacheWriteU32(data, &offset, PINC_CAPABILITY_CACHE_VERSION);
+    pincCapabilityCacheWriteU32(data, &offset, (uint32_t)cache->backend);
+    pincCapabilityCacheWriteU32(data, &offset, cache->framebufferFormatsNum);
+    pincCapabilityCacheWriteU64(data, &offset, cache->configurationHash);
+    pincCapabilityCacheWriteU32(data, &offset, cache->glProbe.probed);
+    for(uint32_t i=0; i<PINC_GL_PROBE_RESULTS_CAPACITY; ++i) {
+        // Unknown results are zeroed for the same reason as unused channels below
+        int32_t result = (cache->glProbe.probed & ((uint32_t)1 << i)) ? cache->glProbe.results[i] : 0;
+        pincCapabilityCacheWriteU32(data, &offset, (uint32_t)result);
+    }
+    for(uint32_t i=0; i<cache->framebufferFormatsNum; ++i) {
+        FramebufferFormat const* format = &cache->framebufferFormats[i];
+        pincCapabilityCacheWriteU32(data, &offset, format->channels);
+        for(uint32_t channel=0; channel<4; ++channel) {
+            // Unused channels are zeroed so identical formats always make identical files
+            pincCapabilityCacheWriteU32(data, &offset, channel < format->channels ? format->channel_bits[channel] : 0);
+        }
+        pincCapabilityCacheWriteU32(data, &offset, (uint32_t)format->color_space);
+    }
+    pincCapabilityCacheWriteU64(data, &offset, pincString_hash((PincString){data, offset}));
+    if(!pincFileWrite((uint8_t const*)staticState.capabilityCachePath, staticState.capabilityCachePathLen, data, size)) {
+        PincLogLiteral(PincLogLevel_warn, "[FRONTEND] [WARN] Could not write the capability cache");
+    }
+    PincAllocator_free(tempAllocator, data, size);
+}
+
+void pincCapabilityCacheDelete(void) {
+    if(staticState.capabilityCachePathLen == 0) {
+        return;
+    }
+    if(!pincFileDelete((uint8_t const*)staticState.capabilityCachePath, staticState.capabilityCachePathLen)) {
+        PincLogLiteral(PincLogLevel_warn, "[FRONTEND] [WARN] Could not delete the capability cache");
+    }
+}
+
+void pincCapabilityCacheFree(PincCapabilityCache* cache, PincAllocator allocator) {
+    if(cache->framebufferFormats) {
+        PincAllocator_free(allocator, cache->framebufferFormats, cache->framebufferFormatsNum * sizeof(FramebufferFormat));
+    }
+    *cache = (PincCapabilityCache){0};
+}
@@ -0,0 +1,41 @@
+#ifndef PINC_CAPABILITY_CACHE_H
+#define PINC_CAPABILITY_CACHE_H
+
+#include "libs/pinc_allocator.h"
+#include "pinc_types.h"
+
+// On-disk cache of what the window backend reports, so the slow queries (like going through every display mode) only happen once per machine.
+// The cache is opt-in through pincPreinitSetCapabilityCachePath.
+// It's keyed by the window backend and its configuration hash (library version, displays, etc), so it goes stale on its own when any of those change.
+// Layout, all in native byte order (a cache from a machine with a different byte order just fails the magic check):
+// - uint32 magic, uint32 version, uint32 window backend, uint32 number of framebuffer formats
+// - uint64 configuration hash
+// - uint32 bits of the OpenGL probe results that are known, int32 OpenGL probe result * PINC_GL_PROBE_RESULTS_CAPACITY
+// - each framebuffer format: uint32 channels, uint32 channel bits * 4, uint32 color space
+// - uint64 checksum of everything before it
+
+// Maximum length of the cache path
+#define PINC_CAPABILITY_CACHE_PATH_CAPACITY 512
+
+typedef struct {
+    PincWindowBackend backend;
+    uint64_t configurationHash;
+    // No formats means they haven't been queried, the cache may have been written for the OpenGL probe alone
+    FramebufferFormat* framebufferFormats;
+    uint32_t framebufferFormatsNum;
+    GlProbeResults glProbe;
+} PincCapabilityCache;
+
+// Load the cache, if it exists and matches the given backend and configuration hash. The formats are allocated on the given allocator.
+bool pincCapabilityCacheLoad(PincCapabilityCache* out, PincWindowBackend backend, uint64_t configurationHash, PincAllocator allocator);
+
+// Write the cache. Failing to write it is not an error, it will just be probed again next time.
+void pincCapabilityCacheStore(PincCapabilityCache const* cache);
+
+// Delete the cache from the disk
+void pincCapabilityCacheDelete(void);
+
+// Free what pincCapabilityCacheLoad allocated
+void pincCapabilityCacheFree(PincCapabilityCache* cache, PincAllocator allocator);
+
+#endif
@@ -6,18 +6,60 @@
 #include <pinc.h>
 // TODO(bluesillybeard): should we make errors use __file__ and __line__ macros?
 
-// NOTE: This function is implemented in pinc_main.c - there is no pinc_error.c
-// Call the error function for a non-fatal error
+// NOTE: These functions are implemented in pinc_main.c - there is no pinc_error.c
+
+// Errors are lazy: only the pointer to the static message (and a copy of the detail, if there is one) is stored when an error happens.
+// The full null terminated message is only put together if something actually needs it (the error callback, or pincLastErrorMessage).
+// An error identical to one that already happened within the same step is not reported again, it just bumps a repeat count.
+
+// Maximum number of bytes of detail that is kept for an error, the rest is cut off
+#define PINC_ERROR_DETAIL_CAPACITY 256
+
+// Number of distinct errors per step that are tracked for collapsing. Error storms tend to cycle between a handful of messages.
+// Any more distinct errors than this are still reported, they just don't get collapsed.
+#define PINC_ERROR_SEEN_CAPACITY 8
+
+// An error that has been reported this step
+typedef struct {
+    // Null for errors whose message was copied
+    char const* staticMessage;
+    // Hash of the detail, or of the whole message if it was copied
+    uint64_t hash;
+    // Copy of the detail, or of the whole message if it was copied. On the temp arena, which outlives the step this entry is forgotten in.
+    // The hash only narrows down the candidates, this is what decides whether two errors are the same.
+    PincString text;
+    PincErrorCode code;
+    bool recoverable;
+    // Number of times it happened again after being reported
+    uint32_t repeats;
+} PincErrorSeen;
+
+// Call the error function for a non-fatal error, with a message that must be copied (because it's on the temp allocator or something)
+// Prefer the other variants where possible, this one always copies the message.
 void pincInternalCallError(PincString message, PincErrorCode type, bool recoverable);
 
+// Call the error function with a static, null terminated message. The message is not copied, so it must live forever - string literals are perfect.
+void pincInternalCallErrorStatic(char const* messageNullterm, PincErrorCode type, bool recoverable);
+
+// Same as pincInternalCallErrorStatic, but with a short-lived, null terminated detail appended to the message (like the result of SDL_GetError).
+// The detail is copied right away, but it's only concatenated onto the message when needed. Detail may be null.
+void pincInternalCallErrorDetail(char const* messageNullterm, char const* detailNullterm, PincErrorCode type, bool recoverable);
+
 // These macros an error if an expression expands to false
 // Usage example: PincAssertExternal(value<=max, "value is too big!", false, {return error_value;});
 // the *Str variant takes a PincString instead of a char*
+// the *Detail variant takes a static message, plus a short-lived null terminated string to put after it
 
 #if PINC_ENABLE_ERROR_EXTERNAL == 1
 # define PincAssertExternal(assertExpression, messageNullterm, recoverable, ...) \
     if(!(assertExpression)) { \
-        pincInternalCallError(pincString_makeDirect((char*)(messageNullterm)), PincErrorCode_external, (recoverable)); \
+        pincInternalCallErrorStatic((char const*)(messageNullterm), PincErrorCode_external, (recoverable)); \
+        __VA_ARGS__\
+    }
+
+# define PincAssertExternalDetail(assertExpression, messageNullterm, detailNullterm, recoverable, ...) \
+    if(!(assertExpression)) { \
+        pincInternalCallErrorDetail((char const*)(messageNullterm), (char const*)(detailNullterm), PincErrorCode_external, (recoverable)); \
         __VA_ARGS__\
     }
 
@@ -28,13 +70,20 @@ void pincInternalCallError(PincString message, PincErrorCode type, bool recovera
     }
 #else
 # define PincAssertExternal(assertExpression, messageNullterm, recoverable, ...)
+# define PincAssertExternalDetail(assertExpression, messageNullterm, detailNullterm, recoverable, ...)
 # define PincAssertExternalStr(assertExpression, messageStr, recoverable, ...)
 #endif
 
 #if PINC_ENABLE_ERROR_ASSERT == 1
 # define PincAssertAssert(assertExpression, messageNullterm, recoverable, ...) \
     if(!(assertExpression)) { \
-        pincInternalCallError(pincString_makeDirect((char*)(messageNullterm)), PincErrorCode_assert, (recoverable)); \
+        pincInternalCallErrorStatic((char const*)(messageNullterm), PincErrorCode_assert, (recoverable)); \
+        __VA_ARGS__\
+    }
+
+# define PincAssertAssertDetail(assertExpression, messageNullterm, detailNullterm, recoverable, ...) \
+    if(!(assertExpression)) { \
+        pincInternalCallErrorDetail((char const*)(messageNullterm), (char const*)(detailNullterm), PincErrorCode_assert, (recoverable)); \
         __VA_ARGS__\
     }
 
@@ -45,13 +94,20 @@ void pincInternalCallError(PincString message, PincErrorCode type, bool recovera
     }
 #else
 # define PincAssertAssert(assertExpression, messageNullterm, recoverable, ...)
+# define PincAssertAssertDetail(assertExpression, messageNullterm, detailNullterm, recoverable, ...)
 # define PincAssertAssertStr(assertExpression, messageStr, recoverable, ...)
 #endif
 
 #if PINC_ENABLE_ERROR_USER == 1
 # define PincAssertUser(assertExpression, messageNullterm, recoverable, ...) \
     if(!(assertExpression)) { \
-        pincInternalCallError(pincString_makeDirect((char*)(messageNullterm)), PincErrorCode_user, (recoverable)); \
+        pincInternalCallErrorStatic((char const*)(messageNullterm), PincErrorCode_user, (recoverable)); \
+        __VA_ARGS__\
+    }
+
+# define PincAssertUserDetail(assertExpression, messageNullterm, detailNullterm, recoverable, ...) \
+    if(!(assertExpression)) { \
+        pincInternalCallErrorDetail((char const*)(messageNullterm), (char const*)(detailNullterm), PincErrorCode_user, (recoverable)); \
         __VA_ARGS__\
     }
 
@@ -62,6 +118,7 @@ void pincInternalCallError(PincString message, PincErrorCode type, bool recovera
     }
 #else
 # define PincAssertUser(assertExpression, messageNullterm, recoverable, ...)
+# define PincAssertUserDetail(assertExpression, messageNullterm, detailNullterm, recoverable, ...)
 # define PincAssertUserStr(assertExpression, messageStr, recoverable, ...)
 #endif
 
@@ -0,0 +1,188 @@
+#include "pinc_log.h"
+#include "libs/pinc_allocator.h"
+#include "pinc_main.h"
+#include "platform/pinc_platform.h"
+
+void pincLogDirect(char const* msg, size_t len) {
+    if(staticState.userLogFn) {
+        char* str2 = PincAllocator_allocate(tempAllocator, len+1);
+        pincMemCopy(msg, str2, len);
+        str2[len] = 0;
+        staticState.userLogFn(staticState.userLogObj, str2, len);
+        PincAllocator_free(tempAllocator, str2, len+1);
+    } else {
+        pincPrintDebugLine((uint8_t const*)msg, len);
+    }
+}
+
+#if P_HAVE_THREAD_LOCAL
+// Set on the thread that is draining the buffer, so the log callback logging something doesn't wait on the lock that thread already holds
+static P_THREAD_LOCAL bool pinc_intern_logFlushingHere P_TLS_INITIAL_EXEC = false;
+#endif
+
+// Take the log's lock, if there is one. Returns whether it was taken.
+static P_INLINE bool pincLogLock(PincLogState* log) {
+    #if P_HAVE_THREAD_LOCAL
+    if(log->lock && !pinc_intern_logFlushingHere) {
+        pincMutexLock(log->lock);
+        return true;
+    }
+    #endif
+    P_UNUSED(log);
+    return false;
+}
+
+static P_INLINE void pincLogUnlock(PincLogState* log, bool locked) {
+    if(locked) {
+        pincMutexUnlock(log->lock);
+    }
+}
+
+// Whether messages can be buffered at all. Before init there is nothing that would drain the buffer,
+// and threads other than the main one would race with the main thread over the buffer, unless it's locked.
+static P_INLINE bool pincLogCanBuffer(void) {
+    #if P_HAVE_THREAD_LOCAL
+    if(pinc_intern_threadTemp && !staticState.log.lock) {
+        return false;
+    }
+    #endif
+    return rootAllocator.vtable != 0 && !staticState.log.flushing;
+}
+
+static void pincLogFlushLocked(void);
+
+static void pincLogAppend(char const* msg, size_t len) {
+    PincLogState* log = &staticState.log;
+    if(log->entriesNum == PINC_LOG_BUFFER_ENTRIES || (size_t)log->textNum + len + 1 > PINC_LOG_BUFFER_SIZE) {
+        pincLogFlushLocked();
+    }
+    if(len + 1 > PINC_LOG_BUFFER_SIZE) {
+        // Doesn't fit even in an empty buffer, it will have to skip the line
+        pincLogDirect(msg, len);
+        return;
+    }
+    pincMemCopy(msg, log->text + log->textNum, len);
+    log->text[log->textNum + len] = '\n';
+    log->textNum += (uint32_t)len + 1;
+    log->entries[log->entriesNum] = (uint32_t)len;
+    log->entriesNum++;
+    if(log->textNum >= PINC_LOG_FLUSH_THRESHOLD || log->entriesNum >= PINC_LOG_FLUSH_THRESHOLD_ENTRIES) {
+        pincLogFlushLocked();
+    }
+}
+
+// Turn the repeat count into a message of its own, if there is one
+static void pincLogEmitRepeats(bool buffered) {
+    PincLogState* log = &staticState.log;
+    if(log->repeatCount == 0) {
+        return;
+    }
+    char buf[96];
+    char const prefix[] = "[LOG] [INFO] Previous message repeated ";
+    char const suffix[] = " more times";
+    size_t len = sizeof(prefix)-1;
+    pincMemCopy(prefix, buf, len);
+    // 10 digits is enough for any uint32, plus the null terminator
+    size_t numLen = pincBufPrintUint32(buf + len, 11, log->repeatCount);
+    len += numLen;
+    pincMemCopy(suffix, buf + len, sizeof(suffix)-1);
+    len += sizeof(suffix)-1;
+    log->repeatCount = 0;
+    if(buffered) {
+        pincLogAppend(buf, len);
+    } else {
+        pincLogDirect(buf, len);
+    }
+}
+
+// Whether a message is the same as the last one. The hash only narrows it down, since two different messages can share a hash.
+static bool pincLogIsRepeat(PincLogState* log, uint64_t hash, char const* msg, size_t len) {
+    if(hash != log->lastHash || len != log->lastLen || len > PINC_LOG_LAST_SIZE) {
+        return false;
+    }
+    for(size_t i=0; i<len; ++i) {
+        if(msg[i] != log->lastText[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void pincLog(PincLogLevel level, char const* msg, size_t len) {
+    PincLogState* log = &staticState.log;
+    bool locked = pincLogLock(log);
+    bool buffered = pincLogCanBuffer();
+    if(buffered) {
+        // Only the main thread gets to collapse messages, since the state for that is shared
+        // Only needs to tell apart consecutive messages
+        uint64_t hash = pincString_hash((PincString){(uint8_t*)msg, len});
+        if(pincLogIsRepeat(log, hash, msg, len)) {
+            log->repeatCount++;
+            pincLogUnlock(log, locked);
+            return;
+        }
+        pincLogEmitRepeats(true);
+        log->lastHash = hash;
+        log->lastLen = len;
+        if(len <= PINC_LOG_LAST_SIZE) {
+            pincMemCopy(msg, log->lastText, len);
+        }
+    }
+    if(!buffered) {
+        pincLogDirect(msg, len);
+    } else if(level >= PincLogLevel_error) {
+        // Errors and fatal messages need to get out right away, but in order
+        pincLogFlushLocked();
+        pincLogDirect(msg, len);
+    } else {
+        pincLogAppend(msg, len);
+    }
+    pincLogUnlock(log, locked);
+}
+
+void pincLogFlush(void) {
+    PincLogState* log = &staticState.log;
+    bool locked = pincLogLock(log);
+    pincLogFlushLocked();
+    pincLogUnlock(log, locked);
+}
+
+// pincLogFlush, for when the lock is already held
+static void pincLogFlushLocked(void) {
+    PincLogState* log = &staticState.log;
+    // This also covers the log callback logging something while the buffer is being drained
+    if(!pincLogCanBuffer()) {
+        return;
+    }
+    // The hash is kept around so the message keeps collapsing if it continues in the next step.
+    // This way a message that repeats every frame only gets through once per step at most.
+    pincLogEmitRepeats(true);
+    if(log->entriesNum == 0) {
+        return;
+    }
+    log->flushing = true;
+    #if P_HAVE_THREAD_LOCAL
+    pinc_intern_logFlushingHere = true;
+    #endif
+    if(staticState.userLogFn) {
+        // The callback wants each message individually and null terminated, so swap each newline for a null terminator while it has the message
+        uint32_t offset = 0;
+        for(uint32_t i=0; i<log->entriesNum; ++i) {
+            uint32_t len = log->entries[i];
+            char* msg = log->text + offset;
+            msg[len] = 0;
+            staticState.userLogFn(staticState.userLogObj, msg, len);
+            msg[len] = '\n';
+            offset += len + 1;
+        }
+    } else {
+        // Each message already ends in a newline, so the whole buffer can go out at once
+        pincPrintDebug((uint8_t const*)log->text, log->textNum);
+    }
+    log->textNum = 0;
+    log->entriesNum = 0;
+    log->flushing = false;
+    #if P_HAVE_THREAD_LOCAL
+    pinc_intern_logFlushingHere = false;
+    #endif
+}
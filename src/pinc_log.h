@@ -0,0 +1,78 @@
+#ifndef PINC_LOG_H
+#define PINC_LOG_H
+
+#include "pinc_options.h"
+#include "libs/pinc_string.h"
+#include "platform/pinc_platform.h"
+
+// Pinc's internal logging.
+// Messages are not written out immediately. Instead, they are appended to a buffer that is drained in pinc_step, at the end of init, and in deinit,
+// so the log callback (or stdout) gets them in batches instead of one syscall per line in the middle of some loop.
+// Errors are the exception - those are written immediately (after anything that was already buffered) since Pinc might not live long enough to drain them.
+// The buffer is also drained once it passes PINC_LOG_FLUSH_THRESHOLD, so a burst of messages goes out in a few large writes rather than waiting for the step.
+// Anything still in the buffer is lost if the process dies without reaching one of those points (a crash, or exit() without pincDeinit).
+// Identical consecutive messages are collapsed into a single "repeated N times" message.
+
+// Suggested log format: [DOMAIN] [LEVEL] [MESSAGE]
+// like "[SDL2] [WARN] something went kinda wrong but it's not a major problem"
+// The level is not added to the message automatically - it's only used for filtering and deciding when the message is written.
+
+typedef enum {
+    PincLogLevel_debug = 0,
+    PincLogLevel_info = 1,
+    PincLogLevel_warn = 2,
+    PincLogLevel_error = 3,
+    PincLogLevel_fatal = 4,
+} PincLogLevel;
+
+// Message text, each message followed by a newline (so the whole thing can be printed in one go)
+#define PINC_LOG_BUFFER_SIZE 16384
+// Maximum number of messages waiting to be drained
+#define PINC_LOG_BUFFER_ENTRIES 256
+// Drain the buffer as soon as it holds this much text or this many messages, instead of waiting until it is full
+#define PINC_LOG_FLUSH_THRESHOLD (PINC_LOG_BUFFER_SIZE / 4 * 3)
+#define PINC_LOG_FLUSH_THRESHOLD_ENTRIES (PINC_LOG_BUFFER_ENTRIES / 4 * 3)
+// A copy of the last message is kept to rule out hash collisions when collapsing. Longer messages are never collapsed.
+#define PINC_LOG_LAST_SIZE 512
+
+typedef struct {
+    char text[PINC_LOG_BUFFER_SIZE];
+    // Length of each message in text, not including the newline
+    uint32_t entries[PINC_LOG_BUFFER_ENTRIES];
+    uint32_t textNum;
+    uint32_t entriesNum;
+    // For collapsing repeated messages
+    uint64_t lastHash;
+    size_t lastLen;
+    // Only valid when lastLen fits. The buffer can't be used for this since the message may have been flushed or skipped it.
+    char lastText[PINC_LOG_LAST_SIZE];
+    uint32_t repeatCount;
+    // Messages logged while the buffer is being drained skip the buffer
+    bool flushing;
+    // Only there while pincInitIncompleteAsync's loading thread is, since it logs into the same buffer as the main thread.
+    // Everything above is only touched while holding it. Only ever made when there are thread locals, see pincLogLock.
+    void* lock;
+} PincLogState;
+
+// Log a message. Use the PincLog* macros instead, so messages below PINC_LOG_MIN_LEVEL are compiled out.
+void pincLog(PincLogLevel level, char const* msg, size_t len);
+
+// Write a message out right now, to the user's log callback or to stdout. No buffering, filtering, or collapsing.
+void pincLogDirect(char const* msg, size_t len);
+
+// Write out everything that is in the log buffer
+void pincLogFlush(void);
+
+// Whether a log level is compiled in. For skipping the work of building a message that would be thrown away anyway.
+#define PincLogEnabled(_level) ((_level) >= PINC_LOG_MIN_LEVEL)
+
+// do while junk in case someone passes a function call into the input, so their function is only called once
+#define PincLogStr(_level, _str) do {if(PincLogEnabled(_level)) {PincString _realstr = (_str); pincLog((_level), (char const*)_realstr.str, _realstr.len);}} while(false)
+
+// The extra "" in this macro is to make sure nobody does a dumb and calls this with anything other than a string literal
+#define PincLogLiteral(_level, _str) do {if(PincLogEnabled(_level)) {pincLog((_level), ("" _str), sizeof(_str)-1);}} while(false)
+
+// do while junk in case someone passes a function call into the input, so their function is only called once
+#define PincLogCstr(_level, _str) do {if(PincLogEnabled(_level)) {char const* _realstr = (char const*)(_str); pincLog((_level), _realstr, pincStringLen(_realstr));}} while(false)
+
+#endif
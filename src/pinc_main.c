@@ -6,57 +6,197 @@
 #include "libs/pinc_string.h"
 #include "pinc_error.h"
 #include "pinc_main.h"
+#include "pinc_none.h"
 #include "pinc_opengl.h"
 #include "pinc_sdl2.h"
 #include "pinc_types.h"
 #include "pinc_window.h"
+#include "platform/pinc_cpu.h"
 #include "platform/pinc_platform.h"
 
 // Implementations of things in pinc_main.h
 
-void pincLogDirect(char const* msg, size_t len) {
-    if(staticState.userAllocFn) {
-        char* str2 = PincAllocator_allocate(tempAllocator, len+1);;
-        pincMemCopy(msg, str2, len);
-        str2[len] = 0;
-        staticState.userLogFn(staticState.userLogObj, str2, len);
-        PincAllocator_free(tempAllocator, str2, len+1);
+// Errors before the root allocator is ready all get the same message, the real one can't be kept around
+static void pincInternalErrorBeforeInit(bool recoverable) {
+    char* errString = "[FRONTEND] [ERROR] Pinc received an error before initialization of the root allocator - Did you forget to call InitComplete()?";
+    size_t errStringLen = pincStringLen(errString);
+    if(staticState.userCallError) {
+        staticState.userCallError((uint8_t const*) errString, errStringLen, PincErrorCode_user, false);
     } else {
-        pincPrintDebugLine((uint8_t const*)msg, len);
+        pincLogDirect(errString, errStringLen);
+    }
+    staticState.lastErrorCode = PincErrorCode_user;
+    staticState.lastErrorStatic = 0;
+    staticState.lastErrorDetailLen = 0;
+    staticState.lastErrorSeen = PINC_ERROR_SEEN_CAPACITY;
+    staticState.lastErrorMessage = (PincString){(uint8_t*)errString, errStringLen};
+    // Although calling an error before the allocator is ready should be recoverable,
+    // The error that came before may not have been.
+    staticState.lastErrorRecoverable = recoverable;
+}
+
+// Put together the full message of the last error, if it hasn't been already
+static PincString pincErrorMaterialize(void) {
+    if(staticState.lastErrorMessage.str || !staticState.lastErrorStatic) {
+        return staticState.lastErrorMessage;
+    }
+    size_t staticLen = pincStringLen(staticState.lastErrorStatic);
+    if(staticState.lastErrorDetailLen == 0) {
+        // The static message is already null terminated, it can be handed out as-is
+        staticState.lastErrorMessage = (PincString){(uint8_t*)staticState.lastErrorStatic, staticLen};
+        return staticState.lastErrorMessage;
+    }
+    size_t len = staticLen + staticState.lastErrorDetailLen;
+    uint8_t* str = PincAllocator_allocate(tempAllocator, len+1);
+    pincMemCopy(staticState.lastErrorStatic, str, staticLen);
+    pincMemCopy(staticState.lastErrorDetail, str + staticLen, staticState.lastErrorDetailLen);
+    str[len] = 0;
+    staticState.lastErrorMessage = (PincString){str, len};
+    return staticState.lastErrorMessage;
+}
+
+// Write out how many times each error was repeated this step, and forget about them.
+static void pincErrorReportRepeats(void) {
+    for(uint32_t i=0; i<staticState.errorsSeenNum; ++i) {
+        PincErrorSeen* seen = &staticState.errorsSeen[i];
+        if(seen->repeats == 0) {
+            continue;
+        }
+        char buf[256];
+        char const prefix[] = "[FRONTEND] [ERROR] Error repeated ";
+        char const suffix[] = " more times: ";
+        size_t len = sizeof(prefix)-1;
+        pincMemCopy(prefix, buf, len);
+        len += pincBufPrintUint32(buf + len, 11, seen->repeats);
+        pincMemCopy(suffix, buf + len, sizeof(suffix)-1);
+        len += sizeof(suffix)-1;
+        // The copy of a dynamic message is still alive, the temp arena it's on is only reset in the step after this one
+        char const* message = seen->staticMessage ? seen->staticMessage : (char const*)seen->text.str;
+        size_t messageLen = seen->staticMessage ? pincStringLen(message) : seen->text.len;
+        if(messageLen > sizeof(buf) - len) {
+            messageLen = sizeof(buf) - len;
+        }
+        pincMemCopy(message, buf + len, messageLen);
+        len += messageLen;
+        pincLog(PincLogLevel_error, buf, len);
+    }
+    staticState.errorsSeenNum = 0;
+    staticState.lastErrorSeen = PINC_ERROR_SEEN_CAPACITY;
+}
+
+// Look for an identical error that was already reported this step. If there isn't one, it's added to the list (if there is room).
+// text is the detail, or the whole message if staticMessage is null. It is copied for the list, so it only has to live for this call.
+// Returns whether the error was seen before, and sets lastErrorSeen either way.
+static bool pincErrorSeenBefore(char const* staticMessage, PincString text, PincErrorCode type, bool recoverable) {
+    uint64_t hash = pincString_hash(text);
+    for(uint32_t i=0; i<staticState.errorsSeenNum; ++i) {
+        PincErrorSeen* seen = &staticState.errorsSeen[i];
+        // Static messages compare by pointer, the rest has to be compared byte for byte
+        if(seen->staticMessage == staticMessage && seen->hash == hash && seen->code == type && seen->recoverable == recoverable
+            && pincString_equal(seen->text, text)) {
+            seen->repeats++;
+            staticState.lastErrorSeen = i;
+            return true;
+        }
+    }
+    if(staticState.errorsSeenNum == PINC_ERROR_SEEN_CAPACITY) {
+        staticState.lastErrorSeen = PINC_ERROR_SEEN_CAPACITY;
+        return false;
+    }
+    staticState.lastErrorSeen = staticState.errorsSeenNum;
+    staticState.errorsSeen[staticState.errorsSeenNum] = (PincErrorSeen){
+        .staticMessage = staticMessage,
+        .hash = hash,
+        // Static messages without detail have nothing to copy
+        .text = (staticMessage && text.len == 0) ? (PincString){0, 0} : (PincString){(uint8_t*)pincString_marshalAlloc(text, tempAllocator), text.len},
+        .code = type,
+        .recoverable = recoverable,
+        .repeats = 0,
+    };
+    staticState.errorsSeenNum++;
+    return false;
+}
+
+// Hand the last error over to the user's callback, or print it
+static void pincErrorReport(void) {
+    if(staticState.userCallError) {
+        // Let's be nice and let the user have their null terminator
+        PincString message = pincErrorMaterialize();
+        staticState.userCallError(message.str, message.len, staticState.lastErrorCode, staticState.lastErrorRecoverable);
+        return;
+    }
+    // Anything logged before the error should show up before it
+    pincLogFlush();
+    if(staticState.lastErrorStatic && staticState.lastErrorDetailLen != 0) {
+        // No need to put the message together just to print it
+        pincPrintError((uint8_t const*)staticState.lastErrorStatic, pincStringLen(staticState.lastErrorStatic));
+        pincPrintErrorLine((uint8_t const*)staticState.lastErrorDetail, staticState.lastErrorDetailLen);
+    } else {
+        PincString message = pincErrorMaterialize();
+        pincPrintErrorLine(message.str, message.len);
     }
 }
 
 void pincInternalCallError(PincString message, PincErrorCode type, bool recoverable) {
     if(rootAllocator.vtable == 0) {
-        char* errString = "[FRONTEND] [ERROR] Pinc received an error before initialization of the root allocator - Did you forget to call InitComplete()?";
-        size_t errStringLen = pincStringLen(errString);
-        if(staticState.userCallError) {
-            staticState.userCallError((uint8_t const*) errString, errStringLen, PincErrorCode_user, false);
-        } else {
-            pincLogDirect(errString, errStringLen);
-        }
-        staticState.lastErrorCode = PincErrorCode_user;
-        staticState.lastErrorMessage = (PincString){(uint8_t*)errString, errStringLen};
-        // Although calling an error before the allocator is ready should be recoverable,
-        // The error that came before may not have been.
-        staticState.lastErrorRecoverable = recoverable;
+        pincInternalErrorBeforeInit(recoverable);
         return;
     }
-    // Let's be nice and let the user have their null terminator
-    char* msgNullTerm = pincString_marshalAlloc(message, tempAllocator);
-    if(staticState.userCallError) {
-        staticState.userCallError((uint8_t*)msgNullTerm, message.len, type, recoverable);
+    bool repeat = pincErrorSeenBefore(0, message, type, recoverable);
+    staticState.lastErrorCode = type;
+    staticState.lastErrorRecoverable = recoverable;
+    staticState.lastErrorStatic = 0;
+    staticState.lastErrorDetailLen = 0;
+    if(staticState.lastErrorSeen != PINC_ERROR_SEEN_CAPACITY) {
+        // The list already has a null terminated copy of this exact message, whether it was just added or is a repeat
+        staticState.lastErrorMessage = staticState.errorsSeen[staticState.lastErrorSeen].text;
     } else {
-        pincPrintErrorLine(message.str, message.len);
+        // The message may not live very long, so this one has to be copied right away
+        staticState.lastErrorMessage = (PincString){(uint8_t*)pincString_marshalAlloc(message, tempAllocator), message.len};
+    }
+    if(!repeat) {
+        pincErrorReport();
     }
+}
+
+void pincInternalCallErrorStatic(char const* messageNullterm, PincErrorCode type, bool recoverable) {
+    pincInternalCallErrorDetail(messageNullterm, 0, type, recoverable);
+}
 
+void pincInternalCallErrorDetail(char const* messageNullterm, char const* detailNullterm, PincErrorCode type, bool recoverable) {
+    if(rootAllocator.vtable == 0) {
+        pincInternalErrorBeforeInit(recoverable);
+        return;
+    }
+    size_t detailLen = detailNullterm ? pincStringLen(detailNullterm) : 0;
+    if(detailLen > PINC_ERROR_DETAIL_CAPACITY) {
+        detailLen = PINC_ERROR_DETAIL_CAPACITY;
+    }
+    if(detailLen) {
+        pincMemCopy(detailNullterm, staticState.lastErrorDetail, detailLen);
+    }
+    bool repeat = pincErrorSeenBefore(messageNullterm, (PincString){(uint8_t*)staticState.lastErrorDetail, detailLen}, type, recoverable);
     staticState.lastErrorCode = type;
-    staticState.lastErrorMessage = (PincString){(uint8_t*)msgNullTerm, message.len};
     staticState.lastErrorRecoverable = recoverable;
+    staticState.lastErrorStatic = messageNullterm;
+    staticState.lastErrorDetailLen = detailLen;
+    // Put together when (if) someone asks for it
+    staticState.lastErrorMessage = (PincString){0, 0};
+    if(!repeat) {
+        pincErrorReport();
+    }
 }
 
 PincStaticState pinc_intern_staticState = PINC_PREINIT_STATE; //NOLINT // This is the ONLY place where non-const globals are allowed. Hence: nolint
 
+#if P_HAVE_THREAD_LOCAL
+// Well, the only place other than this one. Per-thread state can't exactly live in the static state struct.
+P_THREAD_LOCAL PincThreadTempState* pinc_intern_threadTemp P_TLS_INITIAL_EXEC = 0; //NOLINT
+#endif
+
+// And which instance each thread is on. Without thread locals, this is one for the whole process.
+P_THREAD_LOCAL PincStaticState* pinc_intern_currentState P_TLS_INITIAL_EXEC = &pinc_intern_staticState; //NOLINT
+
 // Implementation of pinc's root allocator on top of platform.h
 static void* pinc_root_platform_allocate(void* obj, size_t size) {
     P_UNUSED(obj);
@@ -100,6 +240,131 @@ static const PincAllocatorVtable pinc_user_alloc_vtable = {
     .free = &pinc_root_user_free,
 };
 
+// Implementation of allocator based on per-category user callbacks.
+// The allocator object is the PincUserAllocCallbacks for that category
+static void* pinc_category_user_allocate(void* obj, size_t size) {
+    PincUserAllocCallbacks* callbacks = (PincUserAllocCallbacks*)obj;
+    return callbacks->userAllocFn(callbacks->userAllocObj, size);
+}
+
+static void* pinc_category_user_reallocate(void* obj, void* ptr, size_t oldSize, size_t newSize) {
+    PincUserAllocCallbacks* callbacks = (PincUserAllocCallbacks*)obj;
+    return callbacks->userReallocFn(callbacks->userAllocObj, ptr, oldSize, newSize);
+}
+
+static void pinc_category_user_free(void* obj, void* ptr, size_t size) {
+    PincUserAllocCallbacks* callbacks = (PincUserAllocCallbacks*)obj;
+    callbacks->userFreeFn(callbacks->userAllocObj, ptr, size);
+}
+
+static const PincAllocatorVtable pinc_category_alloc_vtable = {
+    .allocate = &pinc_category_user_allocate,
+    .reallocate = &pinc_category_user_reallocate,
+    .free = &pinc_category_user_free,
+};
+
+// The callbacks a category allocates with, from whatever the user set. All null for platform allocation.
+static PincUserAllocCallbacks pincCategoryCallbacks(PincAllocCategory category) {
+    if(staticState.userCategoryAllocs[category].userAllocFn) {
+        return staticState.userCategoryAllocs[category];
+    }
+    return (PincUserAllocCallbacks) {
+        .userAllocObj = staticState.userAllocObj,
+        .userAllocFn = staticState.userAllocFn,
+        .userReallocFn = staticState.userReallocFn,
+        .userFreeFn = staticState.userFreeFn,
+    };
+}
+
+static bool pincCallbacksEqual(PincUserAllocCallbacks const* a, PincUserAllocCallbacks const* b) {
+    return a->userAllocObj == b->userAllocObj && a->userAllocFn == b->userAllocFn
+        && a->userReallocFn == b->userReallocFn && a->userFreeFn == b->userFreeFn;
+}
+
+// An allocator for a set of callbacks from pincCategoryCallbacks, which must outlive it
+static PincAllocator pincCallbacksAllocator(PincUserAllocCallbacks* callbacks) {
+    if(callbacks->userAllocFn) {
+        return (PincAllocator) {
+            .allocatorObjectPtr = callbacks,
+            .vtable = &pinc_category_alloc_vtable,
+        };
+    }
+    return (PincAllocator) {
+        .allocatorObjectPtr = 0,
+        .vtable = &pinc_platform_alloc_vtable,
+    };
+}
+
+// Free everything in staticState.retained with the callbacks it was allocated with. Works in any state, including preinit.
+static void pincRetainedFree(void) {
+    PincRetainedState* retained = &staticState.retained;
+    if(retained->framebufferFormats) {
+        PincAllocator_free(pincCallbacksAllocator(&retained->objectPoolCallbacks), retained->framebufferFormats, retained->framebufferFormatsNum * sizeof(FramebufferFormat));
+        retained->framebufferFormats = 0;
+        retained->framebufferFormatsNum = 0;
+    }
+    #if PINC_HAVE_WINDOW_SDL2
+    if(retained->sdl2Backend) {
+        // The backend frees its memory from the category allocator, so that has to be the right one while it does
+        PincAllocator previous = categoryAllocator(PincAllocCategory_backend);
+        categoryAllocator(PincAllocCategory_backend) = pincCallbacksAllocator(&retained->backendCallbacks);
+        WindowBackend backend = {.obj = retained->sdl2Backend};
+        retained->sdl2Backend = 0;
+        pincSdl2deinit(&backend);
+        categoryAllocator(PincAllocCategory_backend) = previous;
+    }
+    #endif
+}
+
+#if PINC_ENABLE_ERROR_USER == 1
+static char const* const pinc_steady_state_messages[PincAllocCategory_count] = {
+    "Root allocation in steady state mode (category: temp arena block)",
+    "Root allocation in steady state mode (category: object pool)",
+    "Root allocation in steady state mode (category: event buffer)",
+    "Root allocation in steady state mode (category: string)",
+    "Root allocation in steady state mode (category: backend internals)",
+};
+#endif
+
+static void pinc_category_tracker_count(PincCategoryTracker* tracker) {
+    staticState.rootAllocationsThisStep++;
+    #if PINC_ENABLE_ERROR_USER == 1
+    if(staticState.steadyState && !staticState.steadyStateReporting) {
+        // Reporting the error may need a root allocation of its own
+        staticState.steadyStateReporting = true;
+        PincAssertUser(false, pinc_steady_state_messages[tracker->category], true, {});
+        staticState.steadyStateReporting = false;
+    }
+    #else
+    // Only used for the error message
+    P_UNUSED(tracker);
+    #endif
+}
+
+// Implementation of the category allocators, wrapping whatever allocator actually backs each category
+static void* pinc_category_tracker_allocate(void* obj, size_t size) {
+    PincCategoryTracker* tracker = (PincCategoryTracker*)obj;
+    pinc_category_tracker_count(tracker);
+    return PincAllocator_allocate(tracker->back, size);
+}
+
+static void* pinc_category_tracker_reallocate(void* obj, void* ptr, size_t oldSize, size_t newSize) {
+    PincCategoryTracker* tracker = (PincCategoryTracker*)obj;
+    pinc_category_tracker_count(tracker);
+    return PincAllocator_reallocate(tracker->back, ptr, oldSize, newSize);
+}
+
+static void pinc_category_tracker_free(void* obj, void* ptr, size_t size) {
+    PincCategoryTracker* tracker = (PincCategoryTracker*)obj;
+    PincAllocator_free(tracker->back, ptr, size);
+}
+
+static const PincAllocatorVtable pinc_category_tracker_vtable = {
+    .allocate = &pinc_category_tracker_allocate,
+    .reallocate = &pinc_category_tracker_reallocate,
+    .free = &pinc_category_tracker_free,
+};
+
 static const PincAllocatorVtable PincTempAllocatorVtable = {
     .allocate = &PincArenaAllocator_allocate,
     .allocateAligned = &PincArenaAllocator_allocateAligned,
@@ -110,11 +375,11 @@ static const PincAllocatorVtable PincTempAllocatorVtable = {
 uint32_t PincPool_alloc(PincPool* pool, size_t elementSize) {
     if(pool->objectsCapacity == pool->objectsNum) {
         if(!pool->objectsArray) {
-            pool->objectsArray = PincAllocator_allocate(rootAllocator, elementSize * 8);
+            pool->objectsArray = PincAllocator_allocate(categoryAllocator(PincAllocCategory_objectPool), elementSize * 8);
             pool->objectsCapacity = 8;
         } else {
             uint32_t newObjectsCapacity = pool->objectsCapacity * 2;
-            pool->objectsArray = PincAllocator_reallocate(rootAllocator, pool->objectsArray, elementSize * pool->objectsCapacity, elementSize * newObjectsCapacity);
+            pool->objectsArray = PincAllocator_reallocate(categoryAllocator(PincAllocCategory_objectPool), pool->objectsArray, elementSize * pool->objectsCapacity, elementSize * newObjectsCapacity);
             pool->objectsCapacity = newObjectsCapacity;
         }
     }
@@ -128,16 +393,18 @@ uint32_t PincPool_alloc(PincPool* pool, size_t elementSize) {
 }
 
 void PincPool_free(PincPool* pool, uint32_t index, size_t elementSize) {
+    // The free list is just indices, so the element size doesn't matter here
+    P_UNUSED(elementSize);
     if(index+1 == pool->objectsNum) {
         pool->objectsNum--;
     } else {
         if(pool->freeArrayCapacity == pool->freeArrayNum) {
             if(!pool->freeArray) {
-                pool->freeArray = PincAllocator_allocate(rootAllocator, elementSize * 8);
+                pool->freeArray = PincAllocator_allocate(categoryAllocator(PincAllocCategory_objectPool), sizeof(uint32_t) * 8);
                 pool->freeArrayCapacity = 8;
             } else {
                 uint32_t newObjectsCapacity = pool->freeArrayCapacity * 2;
-                pool->freeArray = PincAllocator_reallocate(rootAllocator, pool->freeArray, elementSize * pool->freeArrayCapacity, elementSize * newObjectsCapacity);
+                pool->freeArray = PincAllocator_reallocate(categoryAllocator(PincAllocCategory_objectPool), pool->freeArray, sizeof(uint32_t) * pool->freeArrayCapacity, sizeof(uint32_t) * newObjectsCapacity);
                 pool->freeArrayCapacity = newObjectsCapacity;
             }
         }
@@ -148,10 +415,10 @@ void PincPool_free(PincPool* pool, uint32_t index, size_t elementSize) {
 
 void PincPool_deinit(PincPool* pool, size_t elementSize) {
     if(pool->objectsArray) {
-        PincAllocator_free(rootAllocator, pool->objectsArray, elementSize * pool->objectsCapacity);
+        PincAllocator_free(categoryAllocator(PincAllocCategory_objectPool), pool->objectsArray, elementSize * pool->objectsCapacity);
     }
     if(pool->freeArray) {
-        PincAllocator_free(rootAllocator, pool->freeArray, sizeof(uint32_t) * pool->freeArrayCapacity);
+        PincAllocator_free(categoryAllocator(PincAllocCategory_objectPool), pool->freeArray, sizeof(uint32_t) * pool->freeArrayCapacity);
     }
     *pool = (PincPool){0};
 }
@@ -247,12 +514,12 @@ void PincObject_free(PincObjectHandle handle) {
 static void PincEventBackEnsureCapacity(uint32_t capacity) {
     if(staticState.eventsBufferBackCapacity >= capacity) { return; }
     if(!staticState.eventsBufferBack) {
-        staticState.eventsBufferBack = PincAllocator_allocate(rootAllocator, 8 * sizeof(PincEvent));
+        staticState.eventsBufferBack = PincAllocator_allocate(categoryAllocator(PincAllocCategory_eventBuffer), 8 * sizeof(PincEvent));
         staticState.eventsBufferBackCapacity = 8;
         staticState.eventsBufferBackNum = 0;
     } else {
         uint32_t newCapacity = staticState.eventsBufferBackCapacity * 2;
-        staticState.eventsBufferBack = PincAllocator_reallocate(rootAllocator, staticState.eventsBufferBack, staticState.eventsBufferBackCapacity * sizeof(PincEvent), newCapacity * sizeof(PincEvent));
+        staticState.eventsBufferBack = PincAllocator_reallocate(categoryAllocator(PincAllocCategory_eventBuffer), staticState.eventsBufferBack, staticState.eventsBufferBackCapacity * sizeof(PincEvent), newCapacity * sizeof(PincEvent));
         staticState.eventsBufferBackCapacity = newCapacity;
     }
 }
@@ -433,51 +700,143 @@ void PincEventFullscreenChanged(int64_t timestamp, PincWindowHandle window, Pinc
     PincEventBackAppend(&event);
 }
 
+// These run on every single API call, so they only exist when sanitize errors are enabled. See settings.md
+// They are reported as assert errors, so without those there would be nothing to call them.
+#if PINC_ENABLE_ERROR_SANITIZE && PINC_ENABLE_ERROR_ASSERT
 // StateValidMacroForConvenience
-#define SttVld(_expr, _message) if(!(_expr)) {PincLogCstr(_message); return false;}
+#define SttVld(_expr, _message) if(!(_expr)) {PincLogLiteral(PincLogLevel_error, "[FRONTEND] [ERROR] " _message); return false;}
+
+#if PINC_ENABLE_ERROR_VALIDATE
+// The rest of these walk every object, so they are only under validate errors
+
+// Whether a framebuffer format's fields are in the ranges pincFramebufferFormatCreate accepts
+static bool PincFramebufferFormatValid(FramebufferFormat const* format) {
+    if(format->channels < 1 || format->channels > 4 || (uint32_t)format->color_space > PincColorSpace_srgb) {
+        return false;
+    }
+    for(uint32_t channel=0; channel<format->channels; ++channel) {
+        if(format->channel_bits[channel] < 1 || format->channel_bits[channel] > 32) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// The free list of a pool has to fit in the pool, and point at slots within it
+static bool PincPool_valid(PincPool const* pool) {
+    if(pool->objectsNum > pool->objectsCapacity || pool->freeArrayNum > pool->objectsNum || pool->freeArrayNum > pool->freeArrayCapacity) {
+        return false;
+    }
+    for(uint32_t i=0; i<pool->freeArrayNum; ++i) {
+        if(pool->freeArray[i] >= pool->objectsNum) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// The pool that holds the internal objects of a given kind
+static PincPool const* PincObject_pool(PincObjectDiscriminator discriminator) {
+    switch(discriminator) {
+        case PincObjectDiscriminator_incompleteWindow: return &staticState.incompleteWindowObjects;
+        case PincObjectDiscriminator_window: return &staticState.windowHandleObjects;
+        case PincObjectDiscriminator_incompleteGlContext: return &staticState.incompleteGlContextObjects;
+        case PincObjectDiscriminator_glContext: return &staticState.rawOpenglContextHandleObjects;
+        case PincObjectDiscriminator_framebufferFormat: return &staticState.framebufferFormatObjects;
+        default: return 0;
+    }
+}
+
+// Whether a handle is 0, or a live object of the given kind
+static bool PincObjectHandleValid(PincObjectHandle handle, PincObjectDiscriminator discriminator) {
+    if(handle == 0) {
+        return true;
+    }
+    return handle <= staticState.objects.objectsNum && ((PincObject*)staticState.objects.objectsArray)[handle-1].discriminator == discriminator;
+}
+
+// Every live object has to have exactly one internal object in the right pool, and the handles the state holds have to be the right kind
+static bool PincStateValidObjects(void) {
+    SttVld(PincPool_valid(&staticState.objects), "Object pool free list is out of bounds");
+    uint32_t liveObjects[PincObjectDiscriminator_framebufferFormat + 1] = {0};
+    PincObject const* objects = (PincObject const*)staticState.objects.objectsArray;
+    for(uint32_t i=0; i<staticState.objects.objectsNum; ++i) {
+        PincObject const* obj = &objects[i];
+        if(obj->discriminator == PincObjectDiscriminator_none) {
+            continue;
+        }
+        PincPool const* pool = PincObject_pool(obj->discriminator);
+        SttVld(pool, "Object has an invalid discriminator");
+        SttVld(obj->internalIndex < pool->objectsNum, "Object's internal index is out of bounds");
+        liveObjects[obj->discriminator]++;
+        if(obj->discriminator == PincObjectDiscriminator_framebufferFormat) {
+            SttVld(PincFramebufferFormatValid(&((FramebufferFormat*)pool->objectsArray)[obj->internalIndex]), "Framebuffer format object has out of range fields");
+        }
+    }
+    for(uint32_t discriminator=PincObjectDiscriminator_incompleteWindow; discriminator<=PincObjectDiscriminator_framebufferFormat; ++discriminator) {
+        PincPool const* pool = PincObject_pool((PincObjectDiscriminator)discriminator);
+        SttVld(PincPool_valid(pool), "Internal object pool free list is out of bounds");
+        SttVld(pool->objectsNum - pool->freeArrayNum == liveObjects[discriminator], "Internal object pool does not match the live objects");
+    }
+    SttVld(PincObjectHandleValid(staticState.currentWindow, PincObjectDiscriminator_window), "Current window is not a live window");
+    SttVld(PincObjectHandleValid(staticState.realCurrentWindow, PincObjectDiscriminator_window), "Real current window is not a live window");
+    SttVld(PincObjectHandleValid(staticState.framebufferFormat, PincObjectDiscriminator_framebufferFormat), "Framebuffer format is not a live framebuffer format object");
+    return true;
+}
+#endif
+
 static bool PincStateValidForIncomplete(void) {
-    #if PINC_ENABLE_ERROR_ASSERT
     // Easy validation with little cost
     SttVld(staticState.alloc.vtable, "Allocator not live")
     SttVld(staticState.tempAlloc.vtable, "Temp allocator not live")
-    // TODO(bluesillybeard): Only window backend is sdl2, shortcuts are taken
-    SttVld(staticState.sdl2WindowBackend.obj, "SDL2 backend not live");
+    SttVld(staticState.sdl2WindowBackend.obj || staticState.noneWindowBackend.obj, "No window backend live");
+    #if PINC_ENABLE_ERROR_VALIDATE
+    // Framebuffer formats can already be made before complete init
+    SttVld(PincStateValidObjects(), "Objects are inconsistent");
     #endif
-    // TODO(bluesillybeard): More difficult validation that costs significant performance
     return true;
 }
 
 static bool PincStateValidForComplete(void) {
     // Easy validation with little cost
-    #if PINC_ENABLE_ERROR_ASSERT
     SttVld(staticState.alloc.vtable, "Allocator not live");
     SttVld(staticState.tempAlloc.vtable, "Temp Allocator not live");
-    // TODO(bluesillybeard): only window backend is sdl2, shortcuts are taken
-    SttVld(staticState.sdl2WindowBackend.obj, "SDL2 backend not live");
+    SttVld(staticState.sdl2WindowBackend.obj || staticState.noneWindowBackend.obj, "No window backend live");
     SttVld(staticState.framebufferFormat, "Framebuffer format not live");
     SttVld(staticState.windowBackend.obj, "Window backend not live");
+    #if PINC_ENABLE_ERROR_VALIDATE
+    SttVld(PincStateValidObjects(), "Objects are inconsistent");
     #endif
-    // TODO(bluesillybeard): More difficult validation that costs significant performance
     return true;
 }
 #undef SttVld
+#endif
 
 // asserts (regular assert) if the state is invalid
-static void PincValidateForState(PincState state) {
+// With assert errors disabled this compiles to nothing, which is what lets the event getters become a plain array load.
+static P_INLINE void PincValidateForState(PincState state) {
     switch (state) {
         case PincState_preinit: {
             // Nothing to validate, other than this is Pinc's actual state
             PincAssertAssert(staticState.initState == PincState_preinit, "Pinc state is not preinit: The user may have called a preinit function after initialization", true, {});
             break;
         }
+        case PincState_loading: {
+            PincAssertAssert(staticState.initState == PincState_loading, "Pinc state is not loading: The user may have called pincInitWait without pincInitIncompleteAsync", true, {});
+            break;
+        }
         case PincState_incomplete: {
             PincAssertAssert(staticState.initState == PincState_incomplete, "Pinc state is not incomplete: The user may have called a function at the wrong time", true, {});
+            #if PINC_ENABLE_ERROR_SANITIZE && PINC_ENABLE_ERROR_ASSERT
             PincAssertAssert(PincStateValidForIncomplete(), "Pinc state is invalid! See error log for details.", false, {});
+            #endif
             break;
         }
         case PincState_init: {
             PincAssertAssert(staticState.initState == PincState_init, "Pinc state is not complete: The user may have called a function before complete initialization", true, {});
+            #if PINC_ENABLE_ERROR_SANITIZE && PINC_ENABLE_ERROR_ASSERT
             PincAssertAssert(PincStateValidForComplete(), "Pinc state is invalid! See error log for details.", false, {});
+            #endif
             break;
         }
     }
@@ -485,7 +844,7 @@ static void PincValidateForState(PincState state) {
 
 // Asserts (regular assert) if the state invalid for either of the given states
 // This is for query functions which can be called both in incomplete and complete init states.
-static void PincValidateForStates(PincState st1, PincState st2) {
+static P_INLINE void PincValidateForStates(PincState st1, PincState st2) {
     PincState realState = st2;
     if(staticState.initState == st1) {
         realState = st1;
@@ -630,13 +989,78 @@ PINC_EXPORT void PINC_CALL pincPreinitSetErrorCallback(PincErrorCallback callbac
     staticState.userCallError = callback;
 }
 
+PINC_EXPORT void PINC_CALL pincPreinitSetCapabilityCachePath(char const* path, uint32_t path_len) {
+    PincValidateForState(PincState_preinit);
+    if(path && path_len == 0) {
+        path_len = (uint32_t)pincStringLen(path);
+    }
+    PincAssertUser(path_len <= PINC_CAPABILITY_CACHE_PATH_CAPACITY, "Capability cache path is too long", true, return;);
+    if(path_len) {
+        pincMemCopy(path, staticState.capabilityCachePath, path_len);
+    }
+    staticState.capabilityCachePathLen = path_len;
+}
+
+PINC_EXPORT PincInstance* PINC_CALL pincInstanceCreate(void) {
+    // There are no allocation callbacks until the instance has been initialized, and it needs to exist before then
+    PincInstance* instance = (PincInstance*)pincAlloc(sizeof(PincInstance));
+    if(!instance) {
+        return 0;
+    }
+    pincMemSet(0, instance, sizeof(PincInstance));
+    return instance;
+}
+
+PINC_EXPORT void PINC_CALL pincInstanceDestroy(PincInstance* instance) {
+    if(!instance) {
+        return;
+    }
+    PincStaticState* previous = pinc_intern_currentState;
+    pinc_intern_currentState = &instance->state;
+    // There is no next time for anything to be retained for
+    staticState.retained.enabled = false;
+    pincDeinit();
+    pinc_intern_currentState = previous == &instance->state ? &pinc_intern_staticState : previous;
+    pincFree(instance, sizeof(PincInstance));
+}
+
+PINC_EXPORT void PINC_CALL pincInstanceMakeCurrent(PincInstance* instance) {
+    pinc_intern_currentState = instance ? &instance->state : &pinc_intern_staticState;
+}
+
+PINC_EXPORT PincInstance* PINC_CALL pincInstanceGetCurrent(void) {
+    if(pinc_intern_currentState == &pinc_intern_staticState) {
+        return 0;
+    }
+    return (PincInstance*)pinc_intern_currentState;
+}
+
+PINC_EXPORT void PINC_CALL pincSetRetainBackend(bool retain) {
+    staticState.retained.enabled = retain;
+}
+
+PINC_EXPORT void PINC_CALL pincCapabilityCacheInvalidate(void) {
+    pincCapabilityCacheDelete();
+}
+
 PINC_EXPORT PincErrorCode PINC_CALL pincLastErrorCode(void) {
     return staticState.lastErrorCode;
 }
 
 PINC_EXPORT char const* PINC_CALL pincLastErrorMessage(size_t* out_len) {
-    if(out_len) { *out_len = staticState.lastErrorMessage.len; }
-    return (char const*) staticState.lastErrorMessage.str;
+    PincString message = {0, 0};
+    if(staticState.lastErrorCode != PincErrorCode_pass) {
+        message = pincErrorMaterialize();
+    }
+    if(out_len) { *out_len = message.len; }
+    return (char const*) message.str;
+}
+
+PINC_EXPORT uint32_t PINC_CALL pincLastErrorRepeatCount(void) {
+    if(staticState.lastErrorCode == PincErrorCode_pass || staticState.lastErrorSeen == PINC_ERROR_SEEN_CAPACITY) {
+        return 0;
+    }
+    return staticState.errorsSeen[staticState.lastErrorSeen].repeats;
 }
 
 PINC_EXPORT bool PINC_CALL pincLastErrorRecoverable(void) {
@@ -655,14 +1079,33 @@ PINC_EXPORT void PINC_CALL pincPreinitSetAllocCallbacks(void* user_ptr, PincAllo
     staticState.userFreeFn = free;
 }
 
+PINC_EXPORT void PINC_CALL pincPreinitSetCategoryAllocCallbacks(PincAllocCategory category, void* user_ptr, PincAllocCallback alloc, PincReallocCallback realloc, PincFreeCallback free) {
+    PincValidateForState(PincState_preinit);
+    PincAssertUser(category < PincAllocCategory_count, "Invalid allocation category", true, return;);
+    PincAssertUser(
+        (alloc && realloc && free)
+        || !(alloc || realloc || free),
+        "Pinc allocator callbacks must either be all set or all null!", true, return;);
+    staticState.userCategoryAllocs[category] = (PincUserAllocCallbacks) {
+        .userAllocObj = user_ptr,
+        .userAllocFn = alloc,
+        .userReallocFn = realloc,
+        .userFreeFn = free,
+    };
+}
+
 PINC_EXPORT void PINC_CALL pincPreinitSetLogCallback(void* user_ptr, PincLogCallback log) {
     PincValidateForState(PincState_preinit);
     staticState.userLogObj = user_ptr;
     staticState.userLogFn = log;
 }
 
-PINC_EXPORT void PINC_CALL pincInitIncomplete(void) {
-    PincValidateForState(PincState_preinit);
+// pincInitIncomplete is done in three parts, so pincInitIncompleteAsync can put the middle one on its own thread.
+// The first part sets up everything that the loading needs
+static void pincInitIncompleteBegin(void) {
+    staticState.startupStart = pincCurrentTimeNanos();
+    // Anything below may want the fast versions of things
+    pincCpuInit();
     // First up, allocator needs set up
     
     if(staticState.userAllocFn) {
@@ -679,70 +1122,335 @@ PINC_EXPORT void PINC_CALL pincInitIncomplete(void) {
         };
     }
 
+    // Then the category allocators, which are just the root allocator unless the user routed them somewhere else
+    for(size_t category=0; category<PincAllocCategory_count; ++category) {
+        PincCategoryTracker* tracker = &staticState.categoryTrackers[category];
+        tracker->category = (PincAllocCategory)category;
+        if(staticState.userCategoryAllocs[category].userAllocFn) {
+            tracker->back = (PincAllocator) {
+                .allocatorObjectPtr = &staticState.userCategoryAllocs[category],
+                .vtable = &pinc_category_alloc_vtable,
+            };
+        } else {
+            tracker->back = rootAllocator;
+        }
+        categoryAllocator(category) = (PincAllocator) {
+            .allocatorObjectPtr = tracker,
+            .vtable = &pinc_category_tracker_vtable,
+        };
+    }
+
+    // Anything retained from last time was allocated with the callbacks from back then, and can only be used if they haven't changed
+    PincUserAllocCallbacks backendCallbacks = pincCategoryCallbacks(PincAllocCategory_backend);
+    PincUserAllocCallbacks objectPoolCallbacks = pincCategoryCallbacks(PincAllocCategory_objectPool);
+    if(!pincCallbacksEqual(&staticState.retained.backendCallbacks, &backendCallbacks)
+        || !pincCallbacksEqual(&staticState.retained.objectPoolCallbacks, &objectPoolCallbacks)) {
+        pincRetainedFree();
+    }
+
     // TODO(bluesillybeard): use the actual OS block size instead of hard-coding 4096
-    PincArenaAllocator_init(&staticState.arenaAllocatorObject, rootAllocator, 0, 4096);
+    PincArenaAllocator_init(&staticState.arenaAllocatorObject, categoryAllocator(PincAllocCategory_tempArena), 0, 4096);
+    PincArenaAllocator_init(&staticState.arenaAllocatorObjectBack, categoryAllocator(PincAllocCategory_tempArena), 0, 4096);
 
-    tempAllocator = (PincAllocator) {
+    staticState.tempAlloc = (PincAllocator) {
         .allocatorObjectPtr = &staticState.arenaAllocatorObject,
         .vtable = &PincTempAllocatorVtable,
     };
 
-    // Begin initialization of window backends
+}
+
+// The second part loads the window backends' libraries. This may be on the loading thread.
+static bool pincInitIncompleteLoad(void) {
+    bool sdl2LoadRes = false;
+    #if PINC_HAVE_WINDOW_SDL2
+    sdl2LoadRes = pincSdl2Load(&staticState.sdl2WindowBackend);
+    #endif
+    staticState.initLoadEnd = pincCurrentTimeNanos();
+    return sdl2LoadRes;
+}
+
+#if P_HAVE_THREAD_LOCAL
+// The argument is the instance that started the load, since a new thread starts out on the default one
+static void pincInitIncompleteThread(void* arg) {
+    pinc_intern_currentState = (PincStaticState*)arg;
+    // The main thread keeps using its temporary arenas in the meantime
+    bool threadTemp = pincTempThreadInit();
+    staticState.initLoaded = pincInitIncompleteLoad();
+    if(threadTemp) {
+        pincTempThreadDeinit();
+    }
+    pincAtomicStoreInt32(&staticState.initLoadDone, 1);
+}
+#endif
+
+// Wait for the loading thread. The log doesn't need its lock after that.
+static void pincInitThreadJoin(void) {
+    pincThreadJoin(staticState.initThread);
+    staticState.initThread = 0;
+    if(staticState.log.lock) {
+        pincMutexDestroy(staticState.log.lock);
+        staticState.log.lock = 0;
+    }
+}
+
+// Give a backend what the capability cache knows about OpenGL, so it only has to probe the rest
+static void pincGlProbeStart(WindowBackend* backendObj) {
+    GlProbeResults known = {0};
+    uint64_t configurationHash = staticState.capabilityCachePathLen ? pincWindowBackend_queryConfigurationHash(backendObj) : 0;
+    PincCapabilityCache cache = {0};
+    if(configurationHash && pincCapabilityCacheLoad(&cache, backendObj->id, configurationHash, tempAllocator)) {
+        known = cache.glProbe;
+        pincCapabilityCacheFree(&cache, tempAllocator);
+    }
+    pincWindowBackend_glProbeStart(backendObj, &known);
+}
+
+// Put whatever the backend has probed about OpenGL into the capability cache, unless it's all there already
+static void pincGlProbeStore(WindowBackend* backendObj) {
+    if(!staticState.capabilityCachePathLen) {
+        return;
+    }
+    GlProbeResults results;
+    if(!pincWindowBackend_glProbeResults(backendObj, &results) || !results.probed) {
+        return;
+    }
+    uint64_t configurationHash = pincWindowBackend_queryConfigurationHash(backendObj);
+    if(!configurationHash) {
+        return;
+    }
+    // The formats in the cache are kept. If it's stale or not there, it gets written with only the probe results.
+    PincCapabilityCache cache = {0};
+    bool loaded = pincCapabilityCacheLoad(&cache, backendObj->id, configurationHash, tempAllocator);
+    if(!loaded || (results.probed & ~cache.glProbe.probed)) {
+        for(uint32_t i=0; i<PINC_GL_PROBE_RESULTS_CAPACITY; ++i) {
+            if(!(results.probed & ((uint32_t)1 << i)) && (cache.glProbe.probed & ((uint32_t)1 << i))) {
+                results.results[i] = cache.glProbe.results[i];
+            }
+        }
+        results.probed |= cache.glProbe.probed;
+        cache.backend = backendObj->id;
+        cache.configurationHash = configurationHash;
+        cache.glProbe = results;
+        pincCapabilityCacheStore(&cache);
+    }
+    pincCapabilityCacheFree(&cache, tempAllocator);
+}
 
+// The third part initializes the loaded backends, on the main thread
+static void pincInitIncompleteFinish(bool loaded) {
+    int64_t finishStart = pincCurrentTimeNanos();
     bool sdl2InitRes = false;
     #if PINC_HAVE_WINDOW_SDL2
-    sdl2InitRes = pincSdl2Init(&staticState.sdl2WindowBackend);
+    if(loaded) {
+        sdl2InitRes = pincSdl2Init(&staticState.sdl2WindowBackend);
+    }
+    #else
+    P_UNUSED(loaded);
+    #endif
+    // The none backend has nothing to load, so it always works
+    bool noneInitRes = false;
+    #if PINC_HAVE_WINDOW_NONE
+    noneInitRes = pincNoneInit(&staticState.noneWindowBackend);
     #endif
 
-    PincAssertExternal(sdl2InitRes, "No supported window backends available!", false, return;);
+    // Failing leaves Pinc in preinit, whether or not it was loading on another thread
+    staticState.initState = PincState_preinit;
+    PincAssertExternal(sdl2InitRes || noneInitRes, "No supported window backends available!", false, return;);
+    if(sdl2InitRes) {
+        pincGlProbeStart(&staticState.sdl2WindowBackend);
+    }
+    if(noneInitRes) {
+        pincGlProbeStart(&staticState.noneWindowBackend);
+    }
+
+    // Framebuffer formats are not queried here, see pincFramebufferFormatsQuery
+    staticState.initState = PincState_incomplete;
+    PincValidateForState(PincState_incomplete);
+    pincLogFlush();
+    // Only the time spent working counts. After pincInitIncompleteAsync, the application may have done its own things between the load and this.
+    pincStartupPhaseRecord(PincStartupPhase_initIncomplete, staticState.startupStart + (finishStart - staticState.initLoadEnd));
+}
+
+PINC_EXPORT void PINC_CALL pincInitIncomplete(void) {
+    PincValidateForState(PincState_preinit);
+    pincInitIncompleteBegin();
+    pincInitIncompleteFinish(pincInitIncompleteLoad());
+}
+
+PINC_EXPORT void PINC_CALL pincInitIncompleteAsync(void) {
+    PincValidateForState(PincState_preinit);
+    pincInitIncompleteBegin();
+    #if P_HAVE_THREAD_LOCAL
+    // The loading thread logs into the same buffer as this one
+    staticState.log.lock = pincMutexCreate();
+    if(staticState.log.lock) {
+        staticState.initState = PincState_loading;
+        staticState.initThread = pincThreadCreate(pincInitIncompleteThread, pinc_intern_currentState);
+    }
+    if(staticState.initThread) {
+        return;
+    }
+    if(staticState.log.lock) {
+        pincMutexDestroy(staticState.log.lock);
+        staticState.log.lock = 0;
+    }
+    #endif
+    // No threads, or no thread locals for the loading thread to have its own temporary arenas. Do it the synchronous way.
+    pincInitIncompleteFinish(pincInitIncompleteLoad());
+}
 
-    // Query collective information from window backends
-    // Again, SDL2 is the only window backend, so some shortcuts can be taken
+PINC_EXPORT bool PINC_CALL pincInitPoll(void) {
+    if(staticState.initState != PincState_loading) {
+        return staticState.initState != PincState_preinit || staticState.lastErrorCode != PincErrorCode_pass;
+    }
+    if(!pincAtomicLoadInt32(&staticState.initLoadDone)) {
+        return false;
+    }
+    pincInitWait();
+    return true;
+}
+
+PINC_EXPORT void PINC_CALL pincInitWait(void) {
+    if(staticState.initState != PincState_loading) {
+        return;
+    }
+    pincInitThreadJoin();
+    pincInitIncompleteFinish(staticState.initLoaded);
+}
+
+// The object for a window backend, or null if it isn't compiled in or didn't load. PincWindowBackend_any is not resolved.
+static WindowBackend* pincWindowBackendGet(PincWindowBackend backend) {
+    WindowBackend* obj = 0;
+    switch(backend) {
+        case PincWindowBackend_sdl2: {
+            obj = &staticState.sdl2WindowBackend;
+            break;
+        }
+        case PincWindowBackend_none: {
+            obj = &staticState.noneWindowBackend;
+            break;
+        }
+        default: {
+            break;
+        }
+    }
+    // A backend that isn't compiled in never loads, so its object stays null
+    return (obj && obj->obj) ? obj : 0;
+}
+
+// Turn PincWindowBackend_any into the default backend, and get the object for it.
+// Null if the backend is not available, in which case the error has already been reported.
+static WindowBackend* pincWindowBackendResolve(PincWindowBackend* backend) {
+    if(*backend == PincWindowBackend_any) {
+        *backend = pincQueryWindowBackendDefault();
+        // pincQueryWindowBackendDefault already said what went wrong
+        if(*backend == PincWindowBackend_any) {
+            return 0;
+        }
+    }
+    WindowBackend* obj = pincWindowBackendGet(*backend);
+    PincAssertUser(obj, "Unsupported window backend", true, return 0;);
+    return obj;
+}
+
+// Get the framebuffer formats from a window backend, if that hasn't happened yet.
+// This is done the first time something needs them instead of in init, since the backend may have to go through every mode of every display to find them.
+// Applications that pass their own format to pincInitComplete never need this at all.
+static PincFramebufferFormatList* pincFramebufferFormatsQuery(PincWindowBackend backend, WindowBackend* backendObj) {
+    PincFramebufferFormatList* list = &staticState.framebufferFormatLists[backend];
+    if(list->queried) {
+        return list;
+    }
+    list->queried = true;
+    int64_t start = pincCurrentTimeNanos();
     size_t numFramebufferFormats = 0;
-    FramebufferFormat* framebufferFormats = pincWindowBackend_queryFramebufferFormats(&staticState.sdl2WindowBackend, tempAllocator, &numFramebufferFormats);
+    FramebufferFormat* framebufferFormats = 0;
+    PincCapabilityCache cache = {0};
+    bool cached = false;
+    uint64_t configurationHash = 0;
+    // The retained formats are still owned by staticState.retained, so they don't get freed at the end. Only SDL2 is retained.
+    bool retained = backend == PincWindowBackend_sdl2 && staticState.retained.framebufferFormatsNum != 0;
+    if(staticState.capabilityCachePathLen && !retained) {
+        configurationHash = pincWindowBackend_queryConfigurationHash(backendObj);
+    }
+    if(retained) {
+        framebufferFormats = staticState.retained.framebufferFormats;
+        numFramebufferFormats = staticState.retained.framebufferFormatsNum;
+    } else if(configurationHash && pincCapabilityCacheLoad(&cache, backend, configurationHash, tempAllocator) && cache.framebufferFormatsNum) {
+        cached = true;
+        framebufferFormats = cache.framebufferFormats;
+        numFramebufferFormats = cache.framebufferFormatsNum;
+    } else {
+        framebufferFormats = pincWindowBackend_queryFramebufferFormats(backendObj, tempAllocator, &numFramebufferFormats);
+        // Only a successful probe is worth remembering. The cache may have had the OpenGL probe results already, those stay.
+        if(configurationHash && numFramebufferFormats) {
+            cache = (PincCapabilityCache){
+                .backend = backend,
+                .configurationHash = configurationHash,
+                .framebufferFormats = framebufferFormats,
+                .framebufferFormatsNum = (uint32_t)numFramebufferFormats,
+                .glProbe = cache.glProbe,
+            };
+            pincCapabilityCacheStore(&cache);
+        }
+    }
+    if(numFramebufferFormats == 0) {
+        pincStartupPhaseRecord(PincStartupPhase_framebufferFormats, start);
+        return list;
+    }
+    list->handles = PincAllocator_allocate(categoryAllocator(PincAllocCategory_objectPool), numFramebufferFormats * sizeof(PincFramebufferFormatHandle));
+    list->handlesNum = (uint32_t)numFramebufferFormats;
     for(size_t i=0; i<numFramebufferFormats; ++i) {
         PincFramebufferFormatHandle handle = PincObject_allocate(PincObjectDiscriminator_framebufferFormat);
         FramebufferFormat* reference = PincObject_ref_framebufferFormat(handle);
         *reference = framebufferFormats[i];
+        list->handles[i] = handle;
     }
 
-    PincAllocator_free(tempAllocator, framebufferFormats, numFramebufferFormats*sizeof(FramebufferFormat));
-    staticState.initState = PincState_incomplete;
-    PincValidateForState(PincState_incomplete);
+    if(cached) {
+        pincCapabilityCacheFree(&cache, tempAllocator);
+    } else if(!retained) {
+        PincAllocator_free(tempAllocator, framebufferFormats, numFramebufferFormats*sizeof(FramebufferFormat));
+    }
+    pincStartupPhaseRecord(PincStartupPhase_framebufferFormats, start);
+    return list;
 }
 
 PINC_EXPORT bool PINC_CALL pincQueryWindowBackendSupport(PincWindowBackend window_backend) {
     PincValidateForStates(PincState_init, PincState_incomplete);
-    // We're assuming that there's at least one supported backend here
-    if(window_backend == PincWindowBackend_any) { return true; }
-    // TODO(bluesillybeard): only backend is SDL2, shortcuts are taken
-    #if PINC_HAVE_WINDOW_SDL2 == 1
-    if(window_backend == PincWindowBackend_sdl2) { return true; }
-    #endif
-    return false;
+    if(window_backend == PincWindowBackend_any) {
+        // Any never means the none backend, see pincQueryWindowBackendDefault
+        window_backend = PincWindowBackend_sdl2;
+    }
+    return pincWindowBackendGet(window_backend) != 0;
 }
 
 PINC_EXPORT PincWindowBackend PINC_CALL pincQueryWindowBackendDefault(void) {
     PincValidateForStates(PincState_init, PincState_incomplete);
-    // TODO(bluesillybeard): only window backend is SDL2, shortcuts are taken
+    // The none backend is always there, so picking it by default would turn a missing display into a silently invisible application
+    PincAssertExternal(pincWindowBackendGet(PincWindowBackend_sdl2), "No window backend with a display is available. Ask for PincWindowBackend_none to run headless.", true, return PincWindowBackend_any;);
     return PincWindowBackend_sdl2;
 }
 
 PINC_EXPORT bool PINC_CALL pincQueryGraphicsApiSupport(PincWindowBackend window_backend, PincGraphicsApi graphics_api) {
     PincValidateForStates(PincState_init, PincState_incomplete);
-    P_UNUSED(window_backend);
+    WindowBackend* backendObj = pincWindowBackendResolve(&window_backend);
+    if(!backendObj) { return false; }
     if(graphics_api == PincGraphicsApi_any) {
         graphics_api = pincQueryGraphicsApiDefault(window_backend);
     }
-    // TODO(bluesillybeard): only window backend is SDL2, shortcuts are taken
-    return pincWindowBackend_queryGraphicsApiSupport(&staticState.sdl2WindowBackend, graphics_api);
+    return pincWindowBackend_queryGraphicsApiSupport(backendObj, graphics_api);
 }
 
 PINC_EXPORT PincGraphicsApi PINC_CALL pincQueryGraphicsApiDefault(PincWindowBackend window_backend) {
     PincValidateForStates(PincState_init, PincState_incomplete);
-    // TODO(bluesillybeard): only api is opengl, shortcuts are taken
-    P_UNUSED(window_backend);
-    return PincGraphicsApi_opengl;
+    WindowBackend* backendObj = pincWindowBackendResolve(&window_backend);
+    if(!backendObj) { return PincGraphicsApi_any; }
+    // Raw is only the default for backends that have nothing better
+    if(pincWindowBackend_queryGraphicsApiSupport(backendObj, PincGraphicsApi_opengl)) {
+        return PincGraphicsApi_opengl;
+    }
+    return PincGraphicsApi_raw;
 }
 
 PINC_EXPORT PincFramebufferFormatHandle pincQueryFramebufferFormatDefault(PincWindowBackend window_backend, PincGraphicsApi graphics_api) {
@@ -763,7 +1471,7 @@ PINC_EXPORT PincFramebufferFormatHandle pincQueryFramebufferFormatDefault(PincWi
 
     PincFramebufferFormatHandle bestFormatHandle = ids[0];
     uint32_t bestScore = 0;
-    for(uint32_t i=1; i<numFramebufferFormats; ++i) {
+    for(uint32_t i=0; i<numFramebufferFormats; ++i) {
         PincFramebufferFormatHandle fmt = ids[i];
         uint32_t channels = pincQueryFramebufferFormatChannels(fmt);
         PincAssertAssert(channels <= 4, "Invalid number of channels", false, return 0;);
@@ -784,26 +1492,38 @@ PINC_EXPORT PincFramebufferFormatHandle pincQueryFramebufferFormatDefault(PincWi
 
 PINC_EXPORT uint32_t PINC_CALL pincQueryFramebufferFormats(PincWindowBackend window_backend, PincGraphicsApi graphics_api, PincFramebufferFormatHandle* handles_dest, uint32_t capacity) {
     PincValidateForStates(PincState_init, PincState_incomplete);
-    P_UNUSED(window_backend);
     P_UNUSED(graphics_api);
-    // TODO(bluesillybeard): only window backend is SDL2, shortcuts are taken
+    WindowBackend* backendObj = pincWindowBackendResolve(&window_backend);
+    if(!backendObj) { return 0; }
     // TODO(bluesillybeard): sort framebuffers from best to worst, so applications can just loop from first to last and pick the first one they see that they like
-    // - Note: probably best to do this in init when all of the framebuffer formats are queried to begin with
-    // - Note 2: Actually, do we need to query framebuffer formats in init? Why not lazy-query them here?
-    PincObjectHandle currentObject = 1;
-    uint32_t currentIndex = 0;
-
-    while(currentObject <= staticState.objects.objectsNum) {
-        PincObject obj = ((PincObject*)staticState.objects.objectsArray)[currentObject-1];
-        if(obj.discriminator == PincObjectDiscriminator_framebufferFormat) {
-            if(currentIndex < capacity && handles_dest) {
-                handles_dest[currentIndex] = currentObject;
-            }
-            currentIndex++;
-        }
-        currentObject++;
+    // - Note: probably best to do this in pincFramebufferFormatsQuery when all of the framebuffer formats are queried to begin with
+    PincFramebufferFormatList* list = pincFramebufferFormatsQuery(window_backend, backendObj);
+    if(handles_dest) {
+        uint32_t numToWrite = capacity < list->handlesNum ? capacity : list->handlesNum;
+        pincMemCopy(list->handles, handles_dest, numToWrite * sizeof(PincFramebufferFormatHandle));
+    }
+    return list->handlesNum;
+}
+
+PINC_EXPORT PincFramebufferFormatHandle PINC_CALL pincFramebufferFormatCreate(uint32_t channels, uint32_t const* channel_bits, PincColorSpace color_space) {
+    PincValidateForStates(PincState_init, PincState_incomplete);
+    PincAssertUser(channels >= 1 && channels <= 4, "Framebuffer formats have 1 to 4 channels", true, return 0;);
+    PincAssertUser(channel_bits, "channel_bits must not be null", true, return 0;);
+    // The same ranges the format struct's fields are checked against under validate errors
+    for(uint32_t channel=0; channel<channels; ++channel) {
+        PincAssertUser(channel_bits[channel] >= 1 && channel_bits[channel] <= 32, "Framebuffer format channels have 1 to 32 bits", true, return 0;);
+    }
+    PincAssertUser((uint32_t)color_space <= PincColorSpace_srgb, "color_space is not a valid PincColorSpace", true, return 0;);
+    PincFramebufferFormatHandle handle = PincObject_allocate(PincObjectDiscriminator_framebufferFormat);
+    FramebufferFormat* format = PincObject_ref_framebufferFormat(handle);
+    *format = (FramebufferFormat){
+        .channels = channels,
+        .color_space = color_space,
+    };
+    for(uint32_t channel=0; channel<channels; ++channel) {
+        format->channel_bits[channel] = channel_bits[channel];
     }
-    return currentIndex;
+    return handle;
 }
 
 PINC_EXPORT uint32_t PINC_CALL pincQueryFramebufferFormatChannels(PincFramebufferFormatHandle handle) {
@@ -826,19 +1546,18 @@ PINC_EXPORT PincColorSpace PINC_CALL pincQueryFramebufferFormatColorSpace(PincFr
 
 PINC_EXPORT uint32_t PINC_CALL pincQueryMaxOpenWindows(PincWindowBackend window_backend) {
     PincValidateForStates(PincState_init, PincState_incomplete);
-    P_UNUSED(window_backend);
-    // TODO(bluesillybeard): only window backend is SDL2, shortcuts are taken
-    return pincWindowBackend_queryMaxOpenWindows(&staticState.sdl2WindowBackend);
+    WindowBackend* backendObj = pincWindowBackendResolve(&window_backend);
+    if(!backendObj) { return 0; }
+    return pincWindowBackend_queryMaxOpenWindows(backendObj);
 }
 
 PINC_EXPORT void PINC_CALL pincInitComplete(PincWindowBackend window_backend, PincGraphicsApi graphics_api, PincFramebufferFormatHandle framebuffer_format_id) {
     if(staticState.initState == PincState_preinit) { pincInitIncomplete(); }
+    pincInitWait();
     PincValidateForState(PincState_incomplete); PincForwardErrorVoid();
-    if(window_backend == PincWindowBackend_any) {
-        // TODO(bluesillybeard): only window backend is SDL2, shortcuts are taken
-        window_backend = PincWindowBackend_sdl2;
-    }
-    PincAssertUser(pincQueryWindowBackendSupport(window_backend), "Unsupported window backend", true, return;);
+    int64_t start = pincCurrentTimeNanos();
+    WindowBackend* backendObj = pincWindowBackendResolve(&window_backend);
+    if(!backendObj) { return; }
     if(graphics_api == PincGraphicsApi_any) {
         graphics_api = pincQueryGraphicsApiDefault(window_backend);
     }
@@ -850,18 +1569,22 @@ PINC_EXPORT void PINC_CALL pincInitComplete(PincWindowBackend window_backend, Pi
     PincForwardErrorVoid();
     FramebufferFormat* framebuffer = PincObject_ref_framebufferFormat(framebuffer_format_id);
     staticState.framebufferFormat = framebuffer_format_id;
-    PincErrorCode result = pincWindowBackend_completeInit(&staticState.sdl2WindowBackend, graphics_api, *framebuffer);
+    PincErrorCode result = pincWindowBackend_completeInit(backendObj, graphics_api, *framebuffer);
     if(result != PincErrorCode_pass) {
         // REFACTOR ME
         // completeInit should have called an error
         PincAssertAssert(pincLastErrorCode() != PincErrorCode_pass, "Got an unknown error from pincWindowBackend_completeInit()", false, return;)
         return;
     }
-    staticState.windowBackend = staticState.sdl2WindowBackend;
+    staticState.windowBackend = *backendObj;
     staticState.windowBackendSet = true;
+    staticState.windowBackendId = window_backend;
+    staticState.graphicsApi = graphics_api;
     staticState.initState = PincState_init;
 
     PincValidateForState(PincState_init);
+    pincLogFlush();
+    pincStartupPhaseRecord(PincStartupPhase_initComplete, start);
 }
 
 PINC_EXPORT void PINC_CALL pincDeinit(void) {
@@ -874,9 +1597,18 @@ PINC_EXPORT void PINC_CALL pincDeinit(void) {
 
     // If the allocator is not initialized, then it means Pinc is not initialized in any capacity and we can just return
     if(rootAllocator.vtable == NULL) {
+        // Other than a backend retained from before, if it isn't wanted anymore
+        if(!staticState.retained.enabled) {
+            pincRetainedFree();
+        }
         return;
     }
 
+    // The loading thread has to be done with the state before any of it can be torn down
+    if(staticState.initThread) {
+        pincInitThreadJoin();
+    }
+
     if(staticState.objects.objectsArray && staticState.objects.objectsCapacity) {
         // Go through every object and destroy it
         for(uint32_t i=0; i<staticState.objects.objectsNum; ++i) {
@@ -903,13 +1635,73 @@ PINC_EXPORT void PINC_CALL pincDeinit(void) {
     }
 
     // deinit backends
-    // TODO(bluesillybeard): only window backend is sdl2, shortcuts are taken
+    // The backend may still be working in the background if init never completed
+    if(staticState.sdl2WindowBackend.obj) {
+        pincWindowBackendSync(&staticState.sdl2WindowBackend);
+    }
+    // Probing may have gone on since the cache was written, or only happened after it
+    if(staticState.sdl2WindowBackend.obj && (staticState.initState == PincState_incomplete || staticState.initState == PincState_init)) {
+        pincGlProbeStore(&staticState.sdl2WindowBackend);
+    }
+    PincRetainedState* retained = &staticState.retained;
+    if(retained->enabled) {
+        // Whatever is already retained was allocated with these same callbacks, or it would have been freed in init
+        retained->backendCallbacks = pincCategoryCallbacks(PincAllocCategory_backend);
+        retained->objectPoolCallbacks = pincCategoryCallbacks(PincAllocCategory_objectPool);
+        // Keep the formats as well, unless they already are
+        PincFramebufferFormatList* sdl2Formats = &staticState.framebufferFormatLists[PincWindowBackend_sdl2];
+        if(!retained->framebufferFormatsNum && sdl2Formats->handlesNum) {
+            retained->framebufferFormats = PincAllocator_allocate(categoryAllocator(PincAllocCategory_objectPool), sdl2Formats->handlesNum * sizeof(FramebufferFormat));
+            for(uint32_t i=0; i<sdl2Formats->handlesNum; ++i) {
+                retained->framebufferFormats[i] = *PincObject_ref_framebufferFormat(sdl2Formats->handles[i]);
+            }
+            retained->framebufferFormatsNum = sdl2Formats->handlesNum;
+        }
+        // A backend that loaded but never got far enough to be set is kept too, the next init can use it all the same
+        #if PINC_HAVE_WINDOW_SDL2
+        bool loaded = staticState.initState == PincState_incomplete || staticState.initState == PincState_init
+            || (staticState.initState == PincState_loading && staticState.initLoaded);
+        if(staticState.sdl2WindowBackend.obj && loaded) {
+            if(staticState.windowBackend.obj == staticState.sdl2WindowBackend.obj) {
+                staticState.windowBackendSet = false;
+                staticState.windowBackend.obj = 0;
+            }
+            retained->sdl2Backend = pincSdl2Retain(&staticState.sdl2WindowBackend);
+            staticState.sdl2WindowBackend.obj = 0;
+        }
+        #endif
+    } else {
+        pincRetainedFree();
+    }
     if(staticState.windowBackendSet) {
         pincWindowBackend_deinit(&staticState.windowBackend);
+        // It's a copy of one of these
+        if(staticState.windowBackend.obj == staticState.sdl2WindowBackend.obj) {
+            staticState.sdl2WindowBackend.obj = 0;
+        }
+        if(staticState.windowBackend.obj == staticState.noneWindowBackend.obj) {
+            staticState.noneWindowBackend.obj = 0;
+        }
         staticState.windowBackendSet = false;
         staticState.windowBackend.obj = 0;
+    }
+    // Backends that loaded but weren't chosen. Those that only got as far as loading (on the loading thread) don't have their vtables yet, so they can't go through the wrappers.
+    bool backendsInitialized = staticState.initState == PincState_incomplete || staticState.initState == PincState_init;
+    if(staticState.sdl2WindowBackend.obj && backendsInitialized) {
+        pincWindowBackend_deinit(&staticState.sdl2WindowBackend);
         staticState.sdl2WindowBackend.obj = 0;
     }
+    // Those that only got as far as loading are deinitialized directly, like pincDeinitFast does
+    #if PINC_HAVE_WINDOW_SDL2
+    if(staticState.sdl2WindowBackend.obj && staticState.initState == PincState_loading && staticState.initLoaded) {
+        pincSdl2deinit(&staticState.sdl2WindowBackend);
+        staticState.sdl2WindowBackend.obj = 0;
+    }
+    #endif
+    if(staticState.noneWindowBackend.obj) {
+        pincWindowBackend_deinit(&staticState.noneWindowBackend);
+        staticState.noneWindowBackend.obj = 0;
+    }
     
     // Destroy any remaining pieces
 
@@ -919,28 +1711,87 @@ PINC_EXPORT void PINC_CALL pincDeinit(void) {
     PincPool_deinit(&staticState.incompleteGlContextObjects, sizeof(IncompleteGlContext));
     PincPool_deinit(&staticState.rawOpenglContextHandleObjects, sizeof(RawOpenglContextObject));
     PincPool_deinit(&staticState.framebufferFormatObjects, sizeof(FramebufferFormat));
+    for(size_t backend=0; backend<sizeof(staticState.framebufferFormatLists) / sizeof(PincFramebufferFormatList); ++backend) {
+        PincFramebufferFormatList* list = &staticState.framebufferFormatLists[backend];
+        if(list->handles) {
+            PincAllocator_free(categoryAllocator(PincAllocCategory_objectPool), list->handles, list->handlesNum * sizeof(PincFramebufferFormatHandle));
+        }
+    }
+
+    if(staticState.eventsBuffer) {
+        PincAllocator_free(categoryAllocator(PincAllocCategory_eventBuffer), staticState.eventsBuffer, staticState.eventsBufferCapacity * sizeof(PincEvent));
+    }
+    if(staticState.eventsBufferBack) {
+        PincAllocator_free(categoryAllocator(PincAllocCategory_eventBuffer), staticState.eventsBufferBack, staticState.eventsBufferBackCapacity * sizeof(PincEvent));
+    }
 
-    PincAllocator_free(rootAllocator, staticState.eventsBuffer, staticState.eventsBufferNum * sizeof(PincEvent));
-    PincAllocator_free(rootAllocator, staticState.eventsBufferBack, staticState.eventsBufferBackNum * sizeof(PincEvent));
+    // Last chance for any log messages to get out
+    pincErrorReportRepeats();
+    pincLogFlush();
 
     if(staticState.tempAlloc.vtable){
         PincArenaAllocator_deinit(&staticState.arenaAllocatorObject);
+        PincArenaAllocator_deinit(&staticState.arenaAllocatorObjectBack);
     }
 
-    // Full reset the state
+    // Full reset the state, other than what is retained for next time
+    PincRetainedState keep = staticState.retained;
+    staticState = (PincStaticState) PINC_PREINIT_STATE;
+    staticState.retained = keep;
+}
+
+PINC_EXPORT void PINC_CALL pincDeinitFast(void) {
+    // The state reset at the end forgets anything retained, but a retained backend still has to let go of the system.
+    // Any other time, it's been taken back by the backend's load already.
+    #if PINC_HAVE_WINDOW_SDL2
+    if(staticState.retained.sdl2Backend) {
+        WindowBackend retainedSdl2 = {.obj = staticState.retained.sdl2Backend};
+        pincSdl2deinitFast(&retainedSdl2);
+    }
+    #endif
+    staticState.retained = (PincRetainedState){0};
+    if(rootAllocator.vtable == NULL) {
+        return;
+    }
+    if(staticState.initThread) {
+        pincInitThreadJoin();
+    }
+    if(staticState.sdl2WindowBackend.obj) {
+        pincWindowBackendSync(&staticState.sdl2WindowBackend);
+    }
+    // Contexts have to go before the backend does, but that's the only per-object work there is
+    if(staticState.windowBackendSet) {
+        for(uint32_t i=0; i<staticState.objects.objectsNum; ++i) {
+            PincObject object = ((PincObject*)staticState.objects.objectsArray)[i];
+            if(object.discriminator == PincObjectDiscriminator_glContext) {
+                pincWindowBackend_glDeinitContext(&staticState.windowBackend, *PincObject_ref_glContext(i+1));
+            }
+        }
+    }
+    if(staticState.windowBackendSet) {
+        pincWindowBackend_deinitFast(&staticState.windowBackend);
+    }
+    // Unlike pincDeinit, this also gets a backend that never made it to being set.
+    // Directly, since one that was only loaded on the loading thread doesn't have its vtable filled in.
+    #if PINC_HAVE_WINDOW_SDL2
+    bool sdl2Set = staticState.windowBackendSet && staticState.windowBackend.obj == staticState.sdl2WindowBackend.obj;
+    if(staticState.sdl2WindowBackend.obj && !sdl2Set && staticState.initState != PincState_preinit) {
+        pincSdl2deinitFast(&staticState.sdl2WindowBackend);
+    }
+    #endif
+    pincErrorReportRepeats();
+    pincLogFlush();
     staticState = (PincStaticState) PINC_PREINIT_STATE;
 }
 
 PINC_EXPORT PincWindowBackend PINC_CALL pincQuerySetWindowBackend(void) {
     PincValidateForState(PincState_init);
-    // TODO(bluesillybeard): only backend is SDL2, shortcuts are taken
-    return PincWindowBackend_sdl2;
+    return staticState.windowBackendId;
 }
 
 PINC_EXPORT PincGraphicsApi PINC_CALL pincQuerySetGraphicsApi(void) {
     PincValidateForState(PincState_init);
-    // TODO(bluesillybeard): only backend is opengl, shortcuts are taken
-    return PincGraphicsApi_opengl;
+    return staticState.graphicsApi;
 }
 
 PINC_EXPORT PincFramebufferFormatHandle PINC_CALL pincQuerySetFramebufferFormat(void) {
@@ -949,7 +1800,7 @@ PINC_EXPORT PincFramebufferFormatHandle PINC_CALL pincQuerySetFramebufferFormat(
 }
 
 PINC_EXPORT PincObjectType PINC_CALL pincGetObjectType(PincObjectHandle handle) {
-    PincValidateForState(PincState_init);
+    PincValidateForStates(PincState_init, PincState_incomplete);
     PincAssertUser(handle <= staticState.objects.objectsNum, "Invalid object id", true, return PincObjectType_none;);
     PincObject obj = ((PincObject*)staticState.objects.objectsArray)[handle-1];
     // TODO(bluesillybeard) Looking at this switch again, it seems we really need to fix the PincObjectType enum
@@ -1012,7 +1863,7 @@ PINC_EXPORT PincWindowHandle PINC_CALL pincWindowCreateIncomplete(void) {
         pincString_makeDirect("Pinc Window "),
         pincString_allocFormatUint32(handle, tempAllocator),
     };
-    PincString name = pincString_concat(sizeof(strings) / sizeof(PincString), strings, rootAllocator);
+    PincString name = pincString_concat(sizeof(strings) / sizeof(PincString), strings, categoryAllocator(PincAllocCategory_string));
     *window = (IncompleteWindow){
         .title = name,
         .hasWidth = false,
@@ -1079,8 +1930,8 @@ PINC_EXPORT void PINC_CALL pincWindowSetTitle(PincWindowHandle window, const cha
             if(title_len == object->title.len) {
                 pincMemCopy(title_buf, object->title.str, title_len);
             } else {
-                pincString_free(&object->title, rootAllocator);
-                object->title = pincString_copy((PincString){.str = (uint8_t*)title_buf, .len = title_len}, rootAllocator);
+                pincString_free(&object->title, categoryAllocator(PincAllocCategory_string));
+                object->title = pincString_copy((PincString){.str = (uint8_t*)title_buf, .len = title_len}, categoryAllocator(PincAllocCategory_string));
             }
             break;
         }
@@ -1088,7 +1939,7 @@ PINC_EXPORT void PINC_CALL pincWindowSetTitle(PincWindowHandle window, const cha
             WindowHandle* object = PincObject_ref_window(window);
             PincForwardErrorVoid();
             // Window takes ownership of the pointer, but we don't have ownership of title_buf
-            uint8_t* titlePtr = (uint8_t*)PincAllocator_allocate(rootAllocator, title_len);
+            uint8_t* titlePtr = (uint8_t*)PincAllocator_allocate(categoryAllocator(PincAllocCategory_string), title_len);
             pincMemCopy(title_buf, titlePtr, title_len);
             pincWindowBackend_setWindowTitle(&staticState.windowBackend, *object, titlePtr, title_len);
             PincForwardErrorVoid();
@@ -1451,20 +2302,161 @@ PINC_EXPORT void PINC_CALL pincWindowPresentFramebuffer(PincWindowHandle complet
     // TODO(bluesillybeard): validate that the object is what it says it is, throw a user error if not
     WindowHandle* object = PincObject_ref_window(complete_window_handle);
     PincForwardErrorVoid();
+    int64_t start = pincCurrentTimeNanos();
     pincWindowBackend_windowPresentFramebuffer(&staticState.windowBackend, *object);
+    if(staticState.startupTimings[PincStartupPhase_firstPresent] == 0) {
+        pincStartupPhaseRecord(PincStartupPhase_firstPresent, start);
+        pincStartupPhaseRecord(PincStartupPhase_timeToFirstFrame, staticState.startupStart);
+    }
+}
+
+PINC_EXPORT void* PINC_CALL pincWindowGetPixels(PincWindowHandle complete_window_handle, uint32_t* out_stride) {
+    PincValidateForState(PincState_init);
+    PincAssertUser(out_stride, "out_stride must not be null", true, return 0;);
+    WindowHandle* object = PincObject_ref_window(complete_window_handle);
+    if(!object) { return 0; }
+    PincAssertUser(staticState.graphicsApi == PincGraphicsApi_raw, "Window pixels are only for the raw graphics api", true, return 0;);
+    return pincWindowBackend_windowGetPixels(&staticState.windowBackend, *object, out_stride);
+}
+
+PINC_EXPORT void PINC_CALL pincWindowReadPixels(PincWindowHandle complete_window_handle, void* dest, uint32_t dest_stride) {
+    PincValidateForState(PincState_init);
+    PincAssertUser(dest, "dest must not be null", true, return;);
+    WindowHandle* object = PincObject_ref_window(complete_window_handle);
+    PincForwardErrorVoid();
+    PincAssertUser(staticState.graphicsApi == PincGraphicsApi_raw, "Window pixels are only for the raw graphics api", true, return;);
+    pincWindowBackend_windowReadPixels(&staticState.windowBackend, *object, dest, dest_stride);
+}
+
+// Whether the pincHeadlessInject* functions can be used
+static bool pincHeadlessCheck(void) {
+    PincValidateForState(PincState_init);
+    PincAssertUser(staticState.windowBackendId == PincWindowBackend_none, "Events can only be injected with the none window backend", true, return false;);
+    return true;
+}
+
+PINC_EXPORT void PINC_CALL pincHeadlessInjectCloseSignal(PincWindowHandle window) {
+    if(!pincHeadlessCheck()) { return; }
+    PincObject_ref_window(window);
+    PincForwardErrorVoid();
+    PincEventCloseSignal(pincCurrentTimeMillis(), window);
+}
+
+PINC_EXPORT void PINC_CALL pincHeadlessInjectResize(PincWindowHandle window, uint32_t width, uint32_t height) {
+    if(!pincHeadlessCheck()) { return; }
+    WindowHandle* object = PincObject_ref_window(window);
+    PincForwardErrorVoid();
+    #if PINC_HAVE_WINDOW_NONE
+    pincNoneInjectResize(&staticState.windowBackend, *object, width, height);
+    #else
+    // Not reachable, pincHeadlessCheck fails without the none backend
+    P_UNUSED(object);
+    P_UNUSED(width);
+    P_UNUSED(height);
+    #endif
+}
+
+PINC_EXPORT void PINC_CALL pincHeadlessInjectFocus(PincWindowHandle window) {
+    if(!pincHeadlessCheck()) { return; }
+    WindowHandle backendWindow = 0;
+    if(window) {
+        WindowHandle* object = PincObject_ref_window(window);
+        PincForwardErrorVoid();
+        backendWindow = *object;
+    }
+    #if PINC_HAVE_WINDOW_NONE
+    pincNoneInjectFocus(&staticState.windowBackend, backendWindow);
+    #else
+    P_UNUSED(backendWindow);
+    #endif
+}
+
+PINC_EXPORT void PINC_CALL pincHeadlessInjectMouseButton(uint32_t state) {
+    if(!pincHeadlessCheck()) { return; }
+    #if PINC_HAVE_WINDOW_NONE
+    pincNoneInjectMouseButton(&staticState.windowBackend, state);
+    #else
+    P_UNUSED(state);
+    #endif
+}
+
+PINC_EXPORT void PINC_CALL pincHeadlessInjectCursorMove(PincWindowHandle window, uint32_t x, uint32_t y) {
+    if(!pincHeadlessCheck()) { return; }
+    WindowHandle* object = PincObject_ref_window(window);
+    PincForwardErrorVoid();
+    #if PINC_HAVE_WINDOW_NONE
+    pincNoneInjectCursorMove(&staticState.windowBackend, *object, x, y);
+    #else
+    P_UNUSED(object);
+    P_UNUSED(x);
+    P_UNUSED(y);
+    #endif
+}
+
+PINC_EXPORT void PINC_CALL pincHeadlessInjectKeyboardButton(PincKeyboardKey key, bool state, bool repeat) {
+    if(!pincHeadlessCheck()) { return; }
+    PincEventKeyboardButton(pincCurrentTimeMillis(), key, state, repeat);
+}
+
+PINC_EXPORT void PINC_CALL pincHeadlessInjectTextInput(uint32_t codepoint) {
+    if(!pincHeadlessCheck()) { return; }
+    PincEventTextInput(pincCurrentTimeMillis(), codepoint);
+}
+
+PINC_EXPORT void PINC_CALL pincHeadlessInjectScroll(float vertical, float horizontal) {
+    if(!pincHeadlessCheck()) { return; }
+    PincEventScroll(pincCurrentTimeMillis(), vertical, horizontal);
+}
+
+PINC_EXPORT void PINC_CALL pincHeadlessSetSyntheticEvents(PincHeadlessSynthetic kind, PincWindowHandle window, uint32_t per_step) {
+    if(!pincHeadlessCheck()) { return; }
+    PincAssertUser(kind < PincHeadlessSynthetic_count, "Invalid synthetic event kind", true, return;);
+    WindowHandle backendWindow = 0;
+    if(window) {
+        WindowHandle* object = PincObject_ref_window(window);
+        PincForwardErrorVoid();
+        backendWindow = *object;
+    }
+    PincAssertUser(backendWindow || per_step == 0 || kind == PincHeadlessSynthetic_keyRepeat || kind == PincHeadlessSynthetic_textInput, "Synthetic cursor moves and resizes need a window", true, return;);
+    #if PINC_HAVE_WINDOW_NONE
+    pincNoneSetSynthetic(&staticState.windowBackend, kind, backendWindow, per_step);
+    #else
+    P_UNUSED(kind);
+    P_UNUSED(backendWindow);
+    P_UNUSED(per_step);
+    #endif
+}
+
+// Swap the front and back temp arenas, and reset the new front one (which is the back one from two steps ago)
+static void PincTempArenaSwap(PincArenaAllocator* front, PincArenaAllocator* back) {
+    PincArenaAllocator tempArena = *front;
+    *front = *back;
+    *back = tempArena;
+    // TODO(bluesillybeard): configurable reset size
+    PincArenaAllocator_reset(front, 6 * front->blockSize);
 }
 
 PINC_EXPORT void PINC_CALL pincStep(void) {
     PincValidateForState(PincState_init);
     PincAssertUser(staticState.windowBackendSet, "Window backend not set. Did you forget to call pincInitComplete?", true, return;);
-    // The arena reset also means the error message must be reset
-    // It is the only lasting object on the temp allocator
+    // The error state is per-step, although the message itself stays valid for one more step thanks to the arena swap below.
     // If someone complains about error states not being preserved across steps, they can file an issue.
+    // Errors only collapse within a step, so this is where the repeat counts are written out
+    pincErrorReportRepeats();
     staticState.lastErrorMessage = (PincString){0, 0};
+    staticState.lastErrorStatic = 0;
+    staticState.lastErrorDetailLen = 0;
     staticState.lastErrorCode = PincErrorCode_pass;
     staticState.lastErrorRecoverable = true;
-    // TODO(bluesillybeard): configurable reset size
-    PincArenaAllocator_reset(&staticState.arenaAllocatorObject, 6 * staticState.arenaAllocatorObject.blockSize);
+    // Temp arena swap. The arena from the previous step becomes the back arena and lives on until the next step,
+    // so the user can hand off event payloads to be processed a frame late without copying them.
+    // Memory is still bounded since the arena being reset here is from two steps ago.
+    PincTempArenaSwap(&staticState.arenaAllocatorObject, &staticState.arenaAllocatorObjectBack);
+    // Everything from here on counts towards the step that is starting, including collecting events
+    staticState.rootAllocationsLastStep = staticState.rootAllocationsThisStep;
+    staticState.rootAllocationsThisStep = 0;
+    // Messages from the last step go out before collecting events, which may log some more
+    pincLogFlush();
     pincWindowBackend_step(&staticState.windowBackend);
     // Event buffer swap
     PincEvent* tempEventsBuffer = staticState.eventsBuffer;
@@ -1479,6 +2471,137 @@ PINC_EXPORT void PINC_CALL pincStep(void) {
     staticState.currentWindow = staticState.realCurrentWindow;
 }
 
+PINC_EXPORT void* PINC_CALL pincTempAlloc(size_t size, size_t alignment) {
+    PincValidateForStates(PincState_init, PincState_incomplete);
+    if(alignment == 0) {
+        // Same as what the arena uses for unaligned allocations
+        alignment = 16;
+    }
+    PincAssertUser((alignment & (alignment-1)) == 0, "Temp allocation alignment must be a power of 2", true, return 0;);
+    return PincAllocator_allocateAligned(tempAllocator, size, alignment);
+}
+
+PINC_EXPORT size_t PINC_CALL pincTempAllocUsage(void) {
+    PincValidateForStates(PincState_init, PincState_incomplete);
+    return PincArenaAllocator_usage(pincTempArenaForThread());
+}
+
+PINC_EXPORT void PINC_CALL pincMarkSteadyState(void) {
+    PincValidateForState(PincState_init);
+    staticState.steadyState = true;
+}
+
+PINC_EXPORT void PINC_CALL pincClearSteadyState(void) {
+    PincValidateForState(PincState_init);
+    staticState.steadyState = false;
+}
+
+PINC_EXPORT uint32_t PINC_CALL pincQueryStepRootAllocations(void) {
+    PincValidateForState(PincState_init);
+    return staticState.rootAllocationsLastStep;
+}
+
+PINC_EXPORT uint32_t PINC_CALL pincQueryStartupTimings(int64_t* nanos_dest, uint32_t capacity) {
+    if(nanos_dest) {
+        uint32_t num = capacity < PincStartupPhase_count ? capacity : PincStartupPhase_count;
+        pincMemCopy(staticState.startupTimings, nanos_dest, num * sizeof(int64_t));
+    }
+    return PincStartupPhase_count;
+}
+
+PINC_EXPORT void PINC_CALL pincFramePacerSetPeriodNanos(int64_t period_nanos) {
+    PincAssertUser(period_nanos >= 0, "Frame pacer period cannot be negative", true, return;);
+    staticState.framePacerPeriod = period_nanos;
+    staticState.framePacerDeadline = 0;
+}
+
+PINC_EXPORT void PINC_CALL pincFramePacerWait(void) {
+    int64_t period = staticState.framePacerPeriod;
+    if(period != 0) {
+        int64_t now = pincCurrentTimeNanos();
+        // Catching up after a hitch would just be a burst of short frames, so start over instead
+        if(staticState.framePacerDeadline == 0 || now - staticState.framePacerDeadline > period) {
+            staticState.framePacerDeadline = now;
+        }
+        pincWaitUntilNanos(staticState.framePacerDeadline);
+        staticState.framePacerDeadline += period;
+    }
+    int64_t wake = pincCurrentTimeNanos();
+    if(staticState.framePacerLastWake != 0) {
+        int64_t frameTime = wake - staticState.framePacerLastWake;
+        // Without a target, the best guess of what the frame time should have been is the last one
+        int64_t expected = period != 0 ? period : staticState.framePacerFrameTime;
+        int64_t deviation = frameTime > expected ? frameTime - expected : expected - frameTime;
+        staticState.framePacerJitter += (deviation - staticState.framePacerJitter) / 16;
+        staticState.framePacerFrameTime = frameTime;
+    }
+    staticState.framePacerLastWake = wake;
+}
+
+PINC_EXPORT int64_t PINC_CALL pincFramePacerQueryFrameTimeNanos(void) {
+    return staticState.framePacerFrameTime;
+}
+
+PINC_EXPORT int64_t PINC_CALL pincFramePacerQueryJitterNanos(void) {
+    return staticState.framePacerJitter;
+}
+
+PINC_EXPORT bool PINC_CALL pincTempThreadInit(void) {
+    #if P_HAVE_THREAD_LOCAL
+    // No PincValidateForStates or PincAssertUser here - reporting an error would mean writing the main thread's error state from another thread.
+    // Misuse returns false instead, which leaves the thread on the main arenas or its existing ones.
+    if(!rootAllocator.vtable || pinc_intern_threadTemp) {
+        return false;
+    }
+    // These skip the category tracker and go straight to the callbacks behind it.
+    // The tracker counts root allocations and raises steady state errors, both of which belong to the main thread.
+    // The callbacks are copied into the record, so pincTempThreadDeinit frees through them even after pincDeinit or from another instance.
+    PincUserAllocCallbacks callbacks = pincCategoryCallbacks(PincAllocCategory_tempArena);
+    PincThreadTempState* threadTemp = PincAllocator_allocate(pincCallbacksAllocator(&callbacks), sizeof(PincThreadTempState));
+    threadTemp->callbacks = callbacks;
+    PincAllocator back = pincCallbacksAllocator(&threadTemp->callbacks);
+    PincArenaAllocator_init(&threadTemp->arenaAllocatorObject, back, 0, 4096);
+    PincArenaAllocator_init(&threadTemp->arenaAllocatorObjectBack, back, 0, 4096);
+    threadTemp->tempAlloc = (PincAllocator) {
+        .allocatorObjectPtr = &threadTemp->arenaAllocatorObject,
+        .vtable = &PincTempAllocatorVtable,
+    };
+    pinc_intern_threadTemp = threadTemp;
+    return true;
+    #else
+    // Without thread locals there is only one error state and one current instance for the whole process,
+    // so reporting this from another thread is no worse than anything else it does.
+    PincAssertExternal(false, "pincTempThreadInit: Pinc was built without thread locals, so every thread shares the main temporary arenas", true, return false;);
+    return false;
+    #endif
+}
+
+PINC_EXPORT void PINC_CALL pincTempThreadStep(void) {
+    #if P_HAVE_THREAD_LOCAL
+    PincThreadTempState* threadTemp = pinc_intern_threadTemp;
+    // Same as pincTempThreadInit, this can't report an error from here
+    if(!threadTemp) {
+        return;
+    }
+    PincTempArenaSwap(&threadTemp->arenaAllocatorObject, &threadTemp->arenaAllocatorObjectBack);
+    #endif
+}
+
+PINC_EXPORT void PINC_CALL pincTempThreadDeinit(void) {
+    #if P_HAVE_THREAD_LOCAL
+    PincThreadTempState* threadTemp = pinc_intern_threadTemp;
+    if(!threadTemp) {
+        return;
+    }
+    PincArenaAllocator_deinit(&threadTemp->arenaAllocatorObject);
+    PincArenaAllocator_deinit(&threadTemp->arenaAllocatorObjectBack);
+    // The record holds the callbacks, so they have to be copied out before it is freed
+    PincUserAllocCallbacks callbacks = threadTemp->callbacks;
+    PincAllocator_free(pincCallbacksAllocator(&callbacks), threadTemp, sizeof(PincThreadTempState));
+    pinc_intern_threadTemp = 0;
+    #endif
+}
+
 PINC_EXPORT uint32_t PINC_CALL pincEventGetNum(void) {
     PincValidateForState(PincState_init);
     return staticState.eventsBufferNum;
@@ -1773,125 +2896,97 @@ PINC_EXPORT PincWindowHandle PINC_CALL pincEventFullscreenChangedWindow(uint32_t
 
 PINC_EXPORT PincOpenglSupportStatus PINC_CALL pincQueryOpenglVersionSupported(PincWindowBackend backend, uint32_t major, uint32_t minor, PincOpenglContextProfile profile) {
     PincValidateForStates(PincState_init, PincState_incomplete);
-    // TODO(bluesillybeard): Only backend is sdl2, shortcuts are taken
-    if(backend == PincWindowBackend_any) {
-        backend = PincWindowBackend_sdl2;
-    }
-    PincAssertUser(backend == PincWindowBackend_sdl2, "Unsupported window backend", true, return PincOpenglSupportStatus_maybe;);
-    PincAssertUser(staticState.sdl2WindowBackend.obj, "No backends initialized - did you forget to call pinc_incomplete_init?", true, return PincOpenglSupportStatus_maybe;);
+    WindowBackend* backendObj = pincWindowBackendResolve(&backend);
+    if(!backendObj) { return PincOpenglSupportStatus_maybe; }
 
-    return pincWindowBackend_queryGlVersionSupported(&staticState.sdl2WindowBackend, major, minor, profile);
+    return pincWindowBackend_queryGlVersionSupported(backendObj, major, minor, profile);
 }
 
 PINC_EXPORT PincOpenglSupportStatus PINC_CALL pincQueryOpenglAccumulatorBits(PincWindowBackend backend, PincFramebufferFormatHandle framebuffer_format_id, uint32_t channel, uint32_t bits){
     PincValidateForStates(PincState_init, PincState_incomplete);
-    // TODO(bluesillybeard): Only backend is sdl2, shortcuts are taken
-    if(backend == PincWindowBackend_any) {
-        backend = PincWindowBackend_sdl2;
-    }
+    WindowBackend* backendObj = pincWindowBackendResolve(&backend);
+    if(!backendObj) { return PincOpenglSupportStatus_maybe; }
     if(framebuffer_format_id == 0) {
         framebuffer_format_id = pincQueryFramebufferFormatDefault(backend, PincGraphicsApi_opengl);
     }
     FramebufferFormat* framebufferFormatObj = PincObject_ref_framebufferFormat(framebuffer_format_id);
-    return pincWindowBackend_queryGlAccumulatorBits(&staticState.sdl2WindowBackend, *framebufferFormatObj, channel, bits);
+    return pincWindowBackend_queryGlAccumulatorBits(backendObj, *framebufferFormatObj, channel, bits);
 }
 
 PINC_EXPORT PincOpenglSupportStatus PINC_CALL pincQueryOpenglAlphaBits(PincWindowBackend backend, PincFramebufferFormatHandle framebuffer_format_id, uint32_t bits) {
     PincValidateForStates(PincState_init, PincState_incomplete);
-    // TODO(bluesillybeard): Only backend is sdl2, shortcuts are taken
-    if(backend == PincWindowBackend_any) {
-        backend = PincWindowBackend_sdl2;
-    }
+    WindowBackend* backendObj = pincWindowBackendResolve(&backend);
+    if(!backendObj) { return PincOpenglSupportStatus_maybe; }
     if(framebuffer_format_id == 0) {
         framebuffer_format_id = pincQueryFramebufferFormatDefault(backend, PincGraphicsApi_opengl);
     }
     FramebufferFormat* framebufferFormatObj = PincObject_ref_framebufferFormat(framebuffer_format_id);
-    return pincWindowBackend_queryGlAlphaBits(&staticState.sdl2WindowBackend, *framebufferFormatObj, bits);
+    return pincWindowBackend_queryGlAlphaBits(backendObj, *framebufferFormatObj, bits);
 }
 
 PINC_EXPORT PincOpenglSupportStatus PINC_CALL pincQueryOpenglDepthBits(PincWindowBackend backend, PincFramebufferFormatHandle framebuffer_format_id, uint32_t bits) {
     PincValidateForStates(PincState_init, PincState_incomplete);
-    // TODO(bluesillybeard): Only backend is sdl2, shortcuts are taken
-    if(backend == PincWindowBackend_any) {
-        backend = PincWindowBackend_sdl2;
-    }
+    WindowBackend* backendObj = pincWindowBackendResolve(&backend);
+    if(!backendObj) { return PincOpenglSupportStatus_maybe; }
     if(framebuffer_format_id == 0) {
         framebuffer_format_id = pincQueryFramebufferFormatDefault(backend, PincGraphicsApi_opengl);
     }
     FramebufferFormat* framebufferFormatObj = PincObject_ref_framebufferFormat(framebuffer_format_id);
-    return pincWindowBackend_queryGlDepthBits(&staticState.sdl2WindowBackend, *framebufferFormatObj, bits);
+    return pincWindowBackend_queryGlDepthBits(backendObj, *framebufferFormatObj, bits);
 }
 
 PINC_EXPORT PincOpenglSupportStatus PINC_CALL pincQueryOpenglStencilBits(PincWindowBackend backend, PincFramebufferFormatHandle framebuffer_format_id, uint32_t bits) {
     PincValidateForStates(PincState_init, PincState_incomplete);
-    // TODO(bluesillybeard): Only backend is sdl2, shortcuts are taken
-    if(backend == PincWindowBackend_any) {
-        backend = PincWindowBackend_sdl2;
-    }
+    WindowBackend* backendObj = pincWindowBackendResolve(&backend);
+    if(!backendObj) { return PincOpenglSupportStatus_maybe; }
     if(framebuffer_format_id == 0) {
         framebuffer_format_id = pincQueryFramebufferFormatDefault(backend, PincGraphicsApi_opengl);
     }
     FramebufferFormat* framebufferFormatObj = PincObject_ref_framebufferFormat(framebuffer_format_id);
-    return pincWindowBackend_queryGlStencilBits(&staticState.sdl2WindowBackend, *framebufferFormatObj, bits);
+    return pincWindowBackend_queryGlStencilBits(backendObj, *framebufferFormatObj, bits);
 }
 
 PINC_EXPORT PincOpenglSupportStatus PINC_CALL pincQueryOpenglSamples(PincWindowBackend backend, PincFramebufferFormatHandle framebuffer_format_handle, uint32_t samples) {
     PincValidateForStates(PincState_init, PincState_incomplete);
-    // TODO(bluesillybeard): Only backend is sdl2, shortcuts are taken
-    if(backend == PincWindowBackend_any) {
-        backend = PincWindowBackend_sdl2;
-    }
+    WindowBackend* backendObj = pincWindowBackendResolve(&backend);
+    if(!backendObj) { return PincOpenglSupportStatus_maybe; }
     if(framebuffer_format_handle == 0) {
         framebuffer_format_handle = pincQueryFramebufferFormatDefault(backend, PincGraphicsApi_opengl);
     }
     FramebufferFormat* framebufferFormatObj = PincObject_ref_framebufferFormat(framebuffer_format_handle);
-    return pincWindowBackend_queryGlSamples(&staticState.sdl2WindowBackend, *framebufferFormatObj, samples);
+    return pincWindowBackend_queryGlSamples(backendObj, *framebufferFormatObj, samples);
 }
 
 PINC_EXPORT PincOpenglSupportStatus PINC_CALL pincQueryOpenglStereoBuffer(PincWindowBackend backend, PincFramebufferFormatHandle framebuffer_format_id) {
     PincValidateForStates(PincState_init, PincState_incomplete);
-    // TODO(bluesillybeard): Only backend is sdl2, shortcuts are taken
-    if(backend == PincWindowBackend_any) {
-        backend = PincWindowBackend_sdl2;
-    }
+    WindowBackend* backendObj = pincWindowBackendResolve(&backend);
+    if(!backendObj) { return PincOpenglSupportStatus_maybe; }
     if(framebuffer_format_id == 0) {
         framebuffer_format_id = pincQueryFramebufferFormatDefault(backend, PincGraphicsApi_opengl);
     }
     FramebufferFormat* framebufferFormatObj = PincObject_ref_framebufferFormat(framebuffer_format_id);
-    return pincWindowBackend_queryGlStereoBuffer(&staticState.sdl2WindowBackend, *framebufferFormatObj);
+    return pincWindowBackend_queryGlStereoBuffer(backendObj, *framebufferFormatObj);
 }
 
 PINC_EXPORT PincOpenglSupportStatus PINC_CALL pincQueryOpenglContextDebug(PincWindowBackend backend){
     PincValidateForStates(PincState_init, PincState_incomplete);
-    // TODO(bluesillybeard): Only backend is sdl2, shortcuts are taken
-    if(backend == PincWindowBackend_any) {
-        backend = PincWindowBackend_sdl2;
-    }
-    PincAssertUser(backend == PincWindowBackend_sdl2, "Unsupported window backend", true, return PincOpenglSupportStatus_maybe;);
-    PincAssertUser(staticState.sdl2WindowBackend.obj, "No backends initialized - did you forget to call pinc_incomplete_init?", true, return PincOpenglSupportStatus_maybe;);
-    return pincWindowBackend_queryGlContextDebug(&staticState.sdl2WindowBackend);
+    WindowBackend* backendObj = pincWindowBackendResolve(&backend);
+    if(!backendObj) { return PincOpenglSupportStatus_maybe; }
+    return pincWindowBackend_queryGlContextDebug(backendObj);
 }
 
 PINC_EXPORT PincOpenglSupportStatus PINC_CALL pincQueryOpenglRobustAccess(PincWindowBackend backend){
     PincValidateForStates(PincState_init, PincState_incomplete);
-    // TODO(bluesillybeard): Only backend is sdl2, shortcuts are taken
-    if(backend == PincWindowBackend_any) {
-        backend = PincWindowBackend_sdl2;
-    }
-    PincAssertUser(backend == PincWindowBackend_sdl2, "Unsupported window backend", true, return PincOpenglSupportStatus_maybe;);
-    PincAssertUser(staticState.sdl2WindowBackend.obj, "No backends initialized - did you forget to call pinc_incomplete_init?", true, return PincOpenglSupportStatus_maybe;);
-    return pincWindowBackend_queryGlRobustAccess(&staticState.sdl2WindowBackend);
+    WindowBackend* backendObj = pincWindowBackendResolve(&backend);
+    if(!backendObj) { return PincOpenglSupportStatus_maybe; }
+    return pincWindowBackend_queryGlRobustAccess(backendObj);
 }
 
 PINC_EXPORT PincOpenglSupportStatus PINC_CALL pincQueryOpenglResetIsolation(PincWindowBackend backend){
     PincValidateForStates(PincState_init, PincState_incomplete);
-    // TODO(bluesillybeard): Only backend is sdl2, shortcuts are taken
-    if(backend == PincWindowBackend_any) {
-        backend = PincWindowBackend_sdl2;
-    }
-    PincAssertUser(backend == PincWindowBackend_sdl2, "Unsupported window backend", true, return PincOpenglSupportStatus_maybe;);
-    PincAssertUser(staticState.sdl2WindowBackend.obj, "No backends initialized - did you forget to call pinc_incomplete_init?", true, return PincOpenglSupportStatus_maybe;);
-    return pincWindowBackend_queryGlResetIsolation(&staticState.sdl2WindowBackend);
+    WindowBackend* backendObj = pincWindowBackendResolve(&backend);
+    if(!backendObj) { return PincOpenglSupportStatus_maybe; }
+    return pincWindowBackend_queryGlResetIsolation(backendObj);
 }
 
 PINC_EXPORT PincOpenglContextHandle PINC_CALL pincOpenglCreateContextIncomplete(void) {
@@ -2202,6 +3297,7 @@ PINC_EXPORT void PINC_CALL pincOpenglMakeCurrent(PincWindowHandle window, PincOp
     }
     PincErrorCode error = pincWindowBackend_glMakeCurrent(&staticState.windowBackend, windowObj, contextObj.handle);
     PincForwardErrorVoid();
+    P_UNUSED(error);
     PincAssertAssert(error == PincErrorCode_pass, "Received unknown error from pincWindowBackend_glMakeCurrent", false, return;)
 }
 
@@ -5,7 +5,9 @@
 
 #include "libs/pinc_allocator.h"
 #include "libs/pinc_arena.h"
+#include "pinc_capability_cache.h"
 #include "pinc_error.h"
+#include "pinc_log.h"
 #include "pinc_options.h"
 #include "pinc_types.h"
 #include "pinc_window.h"
@@ -154,23 +156,74 @@ void PincEventFullscreenChanged(int64_t timestamp, PincWindowHandle window, Pinc
 
 typedef enum {
     PincState_preinit,
+    // pincInitIncompleteAsync has started, and the loading thread hasn't been joined yet
+    PincState_loading,
     PincState_incomplete,
     PincState_init,
 } PincState;
 
+// Sits between categoryAllocator and the real allocator for that category, to count root allocations and enforce steady state mode.
+typedef struct {
+    PincAllocator back;
+    PincAllocCategory category;
+} PincCategoryTracker;
+
+// A set of user allocation callbacks, used as the allocator object for categoryAllocator
+typedef struct {
+    void* userAllocObj;
+    PincAllocCallback userAllocFn;
+    PincReallocCallback userReallocFn;
+    PincFreeCallback userFreeFn;
+} PincUserAllocCallbacks;
+
+// What pincDeinit keeps for the next init, see pincSetRetainBackend. This is the only part of the state that survives pincDeinit.
+// The memory in here is allocated in one init and used in a later one, so that only happens if the allocation callbacks are the same.
+// Otherwise it is freed with the callbacks it was allocated with, see pincRetainedFree.
+typedef struct {
+    bool enabled;
+    // The callbacks for the backend and object pool categories when this was retained. Platform allocation when userAllocFn is null.
+    PincUserAllocCallbacks backendCallbacks;
+    PincUserAllocCallbacks objectPoolCallbacks;
+    // The SDL2 backend's object, still loaded and initialized. Taken back by pincSdl2Load.
+    void* sdl2Backend;
+    // The framebuffer formats from pincFramebufferFormatsQuery, allocated on the object pool category
+    FramebufferFormat* framebufferFormats;
+    uint32_t framebufferFormatsNum;
+} PincRetainedState;
+
+// Framebuffer formats from one window backend, queried the first time something needs them.
+// Only those are listed by pincQueryFramebufferFormats, not ones the user made with pincFramebufferFormatCreate.
+typedef struct {
+    bool queried;
+    // Live when not null, on the object pool category allocator
+    PincFramebufferFormatHandle* handles;
+    uint32_t handlesNum;
+} PincFramebufferFormatList;
+
 typedef struct {
     // Keep track of what stage of initialization we're in
     PincState initState;
+    // For pincInitIncompleteAsync. The loading thread owns everything until initLoadDone is set.
+    void* initThread;
+    PincAtomicInt32 initLoadDone;
+    bool initLoaded;
+    // When the loading finished, so the time before pincInitWait isn't counted in the startup timings
+    int64_t initLoadEnd;
+    PincRetainedState retained;
     // See doc for rootAllocator macro. Live for incomplete and init
     PincAllocator alloc;
     // Memory for tempAlloc object
     PincArenaAllocator arenaAllocatorObject;
+    // The previous step's temp arena. It is swapped with arenaAllocatorObject in pinc_step and only reset on the swap after that,
+    // so temporary data (clipboard data, error messages, etc) stays valid for one extra step. Live for incomplete and init.
+    PincArenaAllocator arenaAllocatorObjectBack;
     // See doc for tempAllocator macro. Live for incomplete and init.
     PincAllocator tempAlloc;
     // Nullable, Lifetime separate from initState
     PincErrorCallback userCallError;
-    // Live for incomplete and init
+    // Live for incomplete and init, each one only if its backend loaded (obj is not null)
     WindowBackend sdl2WindowBackend;
+    WindowBackend noneWindowBackend;
     // Live for init, type: PincObject
     PincPool objects;
     // Live for init, type: IncompleteWindow
@@ -201,6 +254,13 @@ typedef struct {
     // The chosen framebuffer format
     PincFramebufferFormatHandle framebufferFormat;
 
+    // Indexed by PincWindowBackend, see pincFramebufferFormatsQuery
+    PincFramebufferFormatList framebufferFormatLists[PincWindowBackend_sdl2 + 1];
+
+    // Where the capability cache lives, set by the user before init. Not null terminated. Length 0 means the cache is off.
+    char capabilityCachePath[PINC_CAPABILITY_CACHE_PATH_CAPACITY];
+    size_t capabilityCachePathLen;
+
     // Defined by the user, These are either all live or none live
     // userAllocObj can be null while these are live
     void* userAllocObj;
@@ -208,43 +268,126 @@ typedef struct {
     PincReallocCallback userReallocFn;
     PincFreeCallback userFreeFn;
 
+    // Defined by the user, per category. Each one is either all live or none live.
+    // Categories where these are not live fall back to the general callbacks above.
+    PincUserAllocCallbacks userCategoryAllocs[PincAllocCategory_count];
+
+    // See doc for categoryAllocator macro. Live for incomplete and init
+    PincAllocator categoryAllocs[PincAllocCategory_count];
+    // Allocator objects for categoryAllocs, live for incomplete and init
+    PincCategoryTracker categoryTrackers[PincAllocCategory_count];
+
+    // Root allocations (allocate or reallocate on any category) since the last pinc_step, and for the step before that
+    uint32_t rootAllocationsThisStep;
+    uint32_t rootAllocationsLastStep;
+    // After pincMarkSteadyState, any root allocation is a user error
+    bool steadyState;
+    // So the error from a steady state allocation doesn't recurse when the error itself needs a new temp arena block
+    bool steadyStateReporting;
+
+    // See pincStartupPhaseRecord
+    int64_t startupStart;
+    int64_t startupTimings[PincStartupPhase_count];
+
+    // Frame pacer, all in nanoseconds. A deadline of 0 means the next wait starts over.
+    int64_t framePacerPeriod;
+    int64_t framePacerDeadline;
+    int64_t framePacerLastWake;
+    int64_t framePacerFrameTime;
+    int64_t framePacerJitter;
+
     void* userLogObj;
     PincLogCallback userLogFn;
+    // Buffered log messages, see pinc_log.h
+    PincLogState log;
 
     bool windowBackendSet;
     WindowBackend windowBackend;
+    // What pincInitComplete settled on, live with windowBackend
+    PincWindowBackend windowBackendId;
+    PincGraphicsApi graphicsApi;
 
     PincErrorCode lastErrorCode;
-    // Allocated either statically or on the temporary allocator (best to assume the temp allocator)
+    // The full message, allocated either statically or on the temporary allocator (best to assume the temp allocator).
+    // For errors with a static message, this is only filled in once something asks for it. See pinc_error.h
     PincString lastErrorMessage;
     bool lastErrorRecoverable;
+    // Static part of the last error message, or null if the message was copied into lastErrorMessage right away
+    char const* lastErrorStatic;
+    // Copy of the (short-lived) detail that goes after lastErrorStatic
+    char lastErrorDetail[PINC_ERROR_DETAIL_CAPACITY];
+    size_t lastErrorDetailLen;
+    // Distinct errors reported this step, for collapsing repeats
+    PincErrorSeen errorsSeen[PINC_ERROR_SEEN_CAPACITY];
+    uint32_t errorsSeenNum;
+    // Index of the last error in errorsSeen, or PINC_ERROR_SEEN_CAPACITY if it isn't tracked
+    uint32_t lastErrorSeen;
 } PincStaticState;
 
 
 #define PINC_PREINIT_STATE {0}
 
+// The default instance
 extern PincStaticState pinc_intern_staticState; // NOLINT
 
-// shortcuts
-// shortcut to the Pinc global static state struct.
-#define staticState pinc_intern_staticState
-// The primary allocator. This is either a wrapper of libs/platform.h, or the user-defined allocation callbacks
-#define rootAllocator staticState.alloc
-// A temporary allocator that is cleared at the end of pinc_step().
-#define tempAllocator staticState.tempAlloc
+// What pincInstanceCreate returns. Just the state, but it gets its own name in the public header so it's not just a void pointer.
+struct PincInstance {
+    PincStaticState state;
+};
 
-// Suggested log format: [DOMAIN] [TYPE] [MESSAGE]
-// like "[SDL2] [WARN] something went kinda wrong but it's not a major problem"
-void pincLogDirect(char const* msg, size_t len);
+// The instance the calling thread is using. See pincInstanceMakeCurrent.
+extern P_THREAD_LOCAL PincStaticState* pinc_intern_currentState P_TLS_INITIAL_EXEC; // NOLINT
 
-// do while junk in case someone passes a function call into the input, so their function is only called once
-#define PincLogStr(_str) do {PincString _realstr = (_str); pincLogDirect((char const*)_realstr.str, _realstr.len);} while(false)
+// Temp arenas for a thread other than the one that initialized Pinc. See pincTempThreadInit.
+// These work exactly like the main temp arenas, except they are swapped in pincTempThreadStep instead of pinc_step.
+typedef struct {
+    // What the arenas and this record were allocated with, copied from the instance when the thread called pincTempThreadInit
+    PincUserAllocCallbacks callbacks;
+    PincArenaAllocator arenaAllocatorObject;
+    PincArenaAllocator arenaAllocatorObjectBack;
+    PincAllocator tempAlloc;
+} PincThreadTempState;
+
+#if P_HAVE_THREAD_LOCAL
+// Null for the main thread, and any thread that has not called pincTempThreadInit
+extern P_THREAD_LOCAL PincThreadTempState* pinc_intern_threadTemp P_TLS_INITIAL_EXEC; // NOLINT
+#endif
 
-// The extra "" in this macro is to make sure nobody does a dumb and calls this with anything other than a string literal
-#define PincLogLiteral(_str) pincLogDirect(("" _str), sizeof(_str))
+// shortcuts
+// shortcut to the current instance's state struct. This is the default instance unless the thread made another one current.
+#define staticState (*pinc_intern_currentState)
+// The primary allocator. This is either a wrapper of libs/platform.h, or the user-defined allocation callbacks
+#define rootAllocator staticState.alloc
+// The allocator for a specific category of memory (PincAllocCategory). Unless the user routes that category elsewhere, this wraps rootAllocator.
+// All of Pinc's root allocations should go through one of these so they are counted and checked against steady state mode.
+// Allocations from here must be freed on the same category.
+#define categoryAllocator(_category) staticState.categoryAllocs[_category]
+// A temporary allocator that is cleared in pinc_step(), although its memory is double buffered and lasts until the *second* pinc_step() call.
+// Threads that called pincTempThreadInit get their own, which is cleared by pincTempThreadStep() instead.
+// Not an lvalue - use staticState.tempAlloc to set the main thread's temp allocator.
+#define tempAllocator (pincTempAllocatorForThread())
+
+// The calling thread's temp allocator. The main thread's allocator only costs one thread local load and a branch
+static P_INLINE PincAllocator pincTempAllocatorForThread(void) {
+    #if P_HAVE_THREAD_LOCAL
+    PincThreadTempState* threadTemp = pinc_intern_threadTemp;
+    if(threadTemp) {
+        return threadTemp->tempAlloc;
+    }
+    #endif
+    return staticState.tempAlloc;
+}
 
-// do while junk in case someone passes a function call into the input, so their function is only called once
-#define PincLogCstr(_str) do {char const* _realstr = (char const*)(_str); pincLogDirect(_realstr, pincStringLen(_realstr));} while(false)
+// The calling thread's temp arena. See pincTempAllocatorForThread.
+static P_INLINE PincArenaAllocator* pincTempArenaForThread(void) {
+    #if P_HAVE_THREAD_LOCAL
+    PincThreadTempState* threadTemp = pinc_intern_threadTemp;
+    if(threadTemp) {
+        return &threadTemp->arenaAllocatorObject;
+    }
+    #endif
+    return &staticState.arenaAllocatorObject;
+}
 
 PincObjectHandle PincObject_allocate(PincObjectDiscriminator discriminator);
 
@@ -253,6 +396,16 @@ void PincObject_reallocate(PincObjectHandle handle, PincObjectDiscriminator disc
 
 void PincObject_free(PincObjectHandle handle);
 
+// Record how long a startup phase took, given the time it started from pincCurrentTimeNanos.
+// Only the first time counts, since later windows and contexts are not part of startup.
+static P_INLINE void pincStartupPhaseRecord(PincStartupPhase phase, int64_t startNanos) {
+    if(staticState.startupTimings[phase] == 0) {
+        int64_t nanos = pincCurrentTimeNanos() - startNanos;
+        // 0 means it hasn't happened, even on a platform with a coarse clock
+        staticState.startupTimings[phase] = nanos > 0 ? nanos : 1;
+    }
+}
+
 static P_INLINE PincObjectDiscriminator PincObject_discriminator(PincObjectHandle handle) {
     PincAssertUser(handle <= staticState.objects.objectsNum, "Invalid object id", true, return PincObjectDiscriminator_none;);
     PincAssertUser(handle != 0, "Invalid object id", true, return PincObjectDiscriminator_none;);
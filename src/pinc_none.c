@@ -0,0 +1,625 @@
+// To make the build system as simple as possible, backend source files must remove themselves rather than rely on the build system
+#include "pinc_options.h"
+#if PINC_HAVE_WINDOW_NONE
+
+#include <pinc.h>
+#include <pinc_opengl.h>
+
+#include "pinc_error.h"
+#include "pinc_main.h"
+#include "pinc_none.h"
+#include "pinc_types.h"
+#include "pinc_window.h"
+#include "platform/pinc_platform.h"
+#include <libs/pinc_allocator.h>
+#include <libs/pinc_string.h>
+
+typedef struct {
+    PincWindowHandle frontHandle;
+    // Owned by the window, on the string category
+    PincString title;
+    uint32_t width;
+    uint32_t height;
+    bool resizable;
+    bool minimized;
+    PincFullscreenType fullscreen;
+    bool hidden;
+    // Both buffers in one allocation on the backend category, each one height rows of stride bytes.
+    // The one at index front is what was last presented, the other is what the application draws into.
+    uint8_t* pixels;
+    uint32_t stride;
+    uint32_t front;
+} PincNoneWindow;
+
+typedef struct {
+    FramebufferFormat framebuffer;
+    // Bytes per pixel for the framebuffer format. Each channel gets a whole number of bytes.
+    uint32_t pixelSize;
+    bool vsync;
+    // Nullable. What the injected events have said so far, so the next one knows what the old values were.
+    PincNoneWindow* focusedWindow;
+    PincNoneWindow* cursorWindow;
+    uint32_t cursorX;
+    uint32_t cursorY;
+    uint32_t mouseState;
+    // Events generated every step for load testing, indexed by PincHeadlessSynthetic. The window is null for kinds that don't have one.
+    struct {
+        PincNoneWindow* window;
+        uint32_t perStep;
+    } synthetic[PincHeadlessSynthetic_count];
+    // Keeps the generated values moving from one step to the next
+    uint32_t syntheticCounter;
+} PincNoneWindowBackend;
+
+static uint32_t pincNonePixelSize(FramebufferFormat framebuffer) {
+    uint32_t size = 0;
+    for(uint32_t channel=0; channel<framebuffer.channels; ++channel) {
+        size += (framebuffer.channel_bits[channel] + 7) / 8;
+    }
+    return size;
+}
+
+static size_t pincNoneWindowBufferSize(PincNoneWindow* window) {
+    return (size_t)window->stride * window->height;
+}
+
+// (re)allocate a window's pixels for its current size. The contents are cleared to zero.
+static void pincNoneWindowAllocPixels(PincNoneWindowBackend* this, PincNoneWindow* window, uint32_t width, uint32_t height) {
+    if(window->pixels) {
+        PincAllocator_free(categoryAllocator(PincAllocCategory_backend), window->pixels, pincNoneWindowBufferSize(window) * 2);
+        window->pixels = 0;
+    }
+    window->width = width;
+    window->height = height;
+    window->stride = width * this->pixelSize;
+    window->front = 0;
+    size_t bufferSize = pincNoneWindowBufferSize(window);
+    if(bufferSize == 0) {
+        return;
+    }
+    window->pixels = PincAllocator_allocate(categoryAllocator(PincAllocCategory_backend), bufferSize * 2);
+    pincMemSet(0, window->pixels, bufferSize * 2);
+}
+
+FramebufferFormat* pincNonequeryFramebufferFormats(struct WindowBackend* obj, PincAllocator allocator, size_t* outNumFormats) {
+    P_UNUSED(obj);
+    // There is no display to ask, so these are just the formats that make sense for software rendering.
+    // Any format from pincFramebufferFormatCreate works too, as long as each channel fits in 4 bytes.
+    static FramebufferFormat const formats[] = {
+        {.channels = 4, .channel_bits = {8, 8, 8, 8}, .color_space = PincColorSpace_srgb},
+        {.channels = 3, .channel_bits = {8, 8, 8, 0}, .color_space = PincColorSpace_srgb},
+        {.channels = 4, .channel_bits = {8, 8, 8, 8}, .color_space = PincColorSpace_linear},
+        {.channels = 3, .channel_bits = {8, 8, 8, 0}, .color_space = PincColorSpace_linear},
+        {.channels = 1, .channel_bits = {8, 0, 0, 0}, .color_space = PincColorSpace_linear},
+    };
+    size_t const formatsNum = sizeof(formats) / sizeof(FramebufferFormat);
+    FramebufferFormat* result = PincAllocator_allocate(allocator, sizeof(formats));
+    pincMemCopy(formats, result, sizeof(formats));
+    *outNumFormats = formatsNum;
+    return result;
+}
+
+bool pincNonequeryGraphicsApiSupport(struct WindowBackend* obj, PincGraphicsApi api) {
+    P_UNUSED(obj);
+    return api == PincGraphicsApi_raw;
+}
+
+uint32_t pincNonequeryMaxOpenWindows(struct WindowBackend* obj) {
+    P_UNUSED(obj);
+    return 0;
+}
+
+uint64_t pincNonequeryConfigurationHash(struct WindowBackend* obj) {
+    P_UNUSED(obj);
+    // The formats never change and cost nothing to query, so there is nothing worth caching
+    return 0;
+}
+
+void pincNoneglProbeStart(struct WindowBackend* obj, GlProbeResults const* known) {
+    // No OpenGL, nothing to probe
+    P_UNUSED(obj);
+    P_UNUSED(known);
+}
+
+PincErrorCode pincNonecompleteInit(struct WindowBackend* obj, PincGraphicsApi graphicsApi, FramebufferFormat framebuffer) {
+    PincNoneWindowBackend* this = (PincNoneWindowBackend*)obj->obj;
+    // Only checked, and the check may be compiled out
+    P_UNUSED(graphicsApi);
+    // Technically this should never happen, because the user API frontend should have caught this
+    PincAssertUser(graphicsApi == PincGraphicsApi_raw, "The none window backend only supports the raw graphics api", true, return PincErrorCode_user;);
+    for(uint32_t channel=0; channel<framebuffer.channels; ++channel) {
+        PincAssertUser(framebuffer.channel_bits[channel] <= 32, "The none window backend supports up to 32 bits per channel", true, return PincErrorCode_user;);
+    }
+    this->framebuffer = framebuffer;
+    this->pixelSize = pincNonePixelSize(framebuffer);
+    return PincErrorCode_pass;
+}
+
+void pincNonedeinit(struct WindowBackend* obj) {
+    PincAllocator_free(categoryAllocator(PincAllocCategory_backend), obj->obj, sizeof(PincNoneWindowBackend));
+}
+
+void pincNonedeinitFast(struct WindowBackend* obj) {
+    // Nothing here lives outside of the process
+    P_UNUSED(obj);
+}
+
+void pincNonestep(struct WindowBackend* obj) {
+    // Injected events go straight to the event buffer, there is nothing to poll.
+    // Synthetic events are generated here though, so they land in the step that is starting.
+    PincNoneWindowBackend* this = (PincNoneWindowBackend*)obj->obj;
+    // Getting the time is not free, and the point of these is to measure everything else
+    int64_t time = pincCurrentTimeMillis();
+    uint32_t counter = this->syntheticCounter;
+    PincNoneWindow* window = this->synthetic[PincHeadlessSynthetic_cursorMove].window;
+    uint32_t num = this->synthetic[PincHeadlessSynthetic_cursorMove].perStep;
+    if(num > 0 && window->width > 0 && window->height > 0) {
+        // The first one is a transition if the cursor was somewhere else
+        pincNoneInjectCursorMove(obj, window, this->cursorX, this->cursorY);
+        for(uint32_t i=1; i<num; ++i) {
+            uint32_t oldX = this->cursorX;
+            uint32_t oldY = this->cursorY;
+            this->cursorX = (counter + i) % window->width;
+            this->cursorY = (counter + i) % window->height;
+            PincEventCursorMove(time, window->frontHandle, oldX, oldY, this->cursorX, this->cursorY);
+        }
+    }
+    num = this->synthetic[PincHeadlessSynthetic_keyRepeat].perStep;
+    for(uint32_t i=0; i<num; ++i) {
+        PincEventKeyboardButton(time, PincKeyboardKey_space, true, true);
+    }
+    window = this->synthetic[PincHeadlessSynthetic_resize].window;
+    num = this->synthetic[PincHeadlessSynthetic_resize].perStep;
+    if(num > 0) {
+        // Only the events alternate, the pixels are reallocated once at the end if the size actually changed.
+        // Otherwise this would be measuring the allocator.
+        uint32_t width = window->width;
+        uint32_t height = window->height;
+        for(uint32_t i=0; i<num; ++i) {
+            uint32_t newWidth = (i % 2 == 0) ? width + 1 : width - 1;
+            uint32_t newHeight = (i % 2 == 0) ? height + 1 : height - 1;
+            PincEventResize(time, window->frontHandle, width, height, newWidth, newHeight);
+            width = newWidth;
+            height = newHeight;
+        }
+        if(width != window->width || height != window->height) {
+            pincNoneWindowAllocPixels(this, window, width, height);
+        }
+    }
+    num = this->synthetic[PincHeadlessSynthetic_textInput].perStep;
+    for(uint32_t i=0; i<num; ++i) {
+        PincEventTextInput(time, 'a' + (counter + i) % 26);
+    }
+    this->syntheticCounter = counter + 1;
+}
+
+WindowHandle pincNonecompleteWindow(struct WindowBackend* obj, IncompleteWindow const * incomplete, PincWindowHandle frontHandle) {
+    PincNoneWindowBackend* this = (PincNoneWindowBackend*)obj->obj;
+    PincNoneWindow* window = PincAllocator_allocate(categoryAllocator(PincAllocCategory_backend), sizeof(PincNoneWindow));
+    *window = (PincNoneWindow){
+        .frontHandle = frontHandle,
+        // They gave us ownership
+        .title = incomplete->title,
+        .resizable = incomplete->resizable,
+        .minimized = incomplete->minimized,
+        .fullscreen = incomplete->fullscreen,
+        .hidden = incomplete->hidden,
+    };
+    // Same default size as SDL2
+    pincNoneWindowAllocPixels(this, window, incomplete->hasWidth ? incomplete->width : 256, incomplete->hasHeight ? incomplete->height : 256);
+    if(incomplete->focused) {
+        this->focusedWindow = window;
+    }
+    return window;
+}
+
+void pincNonedeinitWindow(struct WindowBackend* obj, WindowHandle windowHandle) {
+    PincNoneWindowBackend* this = (PincNoneWindowBackend*)obj->obj;
+    PincNoneWindow* window = (PincNoneWindow*)windowHandle;
+    if(this->focusedWindow == window) {
+        this->focusedWindow = 0;
+    }
+    if(this->cursorWindow == window) {
+        this->cursorWindow = 0;
+    }
+    for(uint32_t i=0; i<PincHeadlessSynthetic_count; ++i) {
+        if(this->synthetic[i].window == window) {
+            this->synthetic[i].window = 0;
+            this->synthetic[i].perStep = 0;
+        }
+    }
+    if(window->pixels) {
+        PincAllocator_free(categoryAllocator(PincAllocCategory_backend), window->pixels, pincNoneWindowBufferSize(window) * 2);
+    }
+    pincString_free(&window->title, categoryAllocator(PincAllocCategory_string));
+    PincAllocator_free(categoryAllocator(PincAllocCategory_backend), window, sizeof(PincNoneWindow));
+}
+
+void pincNonesetWindowTitle(struct WindowBackend* obj, WindowHandle windowHandle, uint8_t* title, size_t titleLen) {
+    P_UNUSED(obj);
+    PincNoneWindow* window = (PincNoneWindow*)windowHandle;
+    pincString_free(&window->title, categoryAllocator(PincAllocCategory_string));
+    // We take ownership of the title
+    window->title = (PincString){.str = title, .len = titleLen};
+}
+
+uint8_t const * pincNonegetWindowTitle(struct WindowBackend* obj, WindowHandle windowHandle, size_t* outTitleLen) {
+    P_UNUSED(obj);
+    PincNoneWindow* window = (PincNoneWindow*)windowHandle;
+    *outTitleLen = window->title.len;
+    return window->title.str;
+}
+
+void pincNonesetWindowWidth(struct WindowBackend* obj, WindowHandle windowHandle, uint32_t width) {
+    PincNoneWindowBackend* this = (PincNoneWindowBackend*)obj->obj;
+    PincNoneWindow* window = (PincNoneWindow*)windowHandle;
+    if(window->width != width) {
+        pincNoneWindowAllocPixels(this, window, width, window->height);
+    }
+}
+
+uint32_t pincNonegetWindowWidth(struct WindowBackend* obj, WindowHandle windowHandle) {
+    P_UNUSED(obj);
+    return ((PincNoneWindow*)windowHandle)->width;
+}
+
+void pincNonesetWindowHeight(struct WindowBackend* obj, WindowHandle windowHandle, uint32_t height) {
+    PincNoneWindowBackend* this = (PincNoneWindowBackend*)obj->obj;
+    PincNoneWindow* window = (PincNoneWindow*)windowHandle;
+    if(window->height != height) {
+        pincNoneWindowAllocPixels(this, window, window->width, height);
+    }
+}
+
+uint32_t pincNonegetWindowHeight(struct WindowBackend* obj, WindowHandle windowHandle) {
+    P_UNUSED(obj);
+    return ((PincNoneWindow*)windowHandle)->height;
+}
+
+float pincNonegetWindowScaleFactor(struct WindowBackend* obj, WindowHandle windowHandle) {
+    P_UNUSED(obj);
+    P_UNUSED(windowHandle);
+    // No display, so one pixel is one pixel
+    return 1;
+}
+
+void pincNonesetWindowResizable(struct WindowBackend* obj, WindowHandle windowHandle, bool resizable) {
+    P_UNUSED(obj);
+    ((PincNoneWindow*)windowHandle)->resizable = resizable;
+}
+
+bool pincNonegetWindowResizable(struct WindowBackend* obj, WindowHandle windowHandle) {
+    P_UNUSED(obj);
+    return ((PincNoneWindow*)windowHandle)->resizable;
+}
+
+void pincNonesetWindowMinimized(struct WindowBackend* obj, WindowHandle windowHandle, bool minimized) {
+    P_UNUSED(obj);
+    ((PincNoneWindow*)windowHandle)->minimized = minimized;
+}
+
+bool pincNonegetWindowMinimized(struct WindowBackend* obj, WindowHandle windowHandle) {
+    P_UNUSED(obj);
+    return ((PincNoneWindow*)windowHandle)->minimized;
+}
+
+void pincNonesetWindowFullscreen(struct WindowBackend* obj, WindowHandle windowHandle, PincFullscreenType fullscreen) {
+    P_UNUSED(obj);
+    ((PincNoneWindow*)windowHandle)->fullscreen = fullscreen;
+}
+
+PincFullscreenType pincNonegetWindowFullscreen(struct WindowBackend* obj, WindowHandle windowHandle) {
+    P_UNUSED(obj);
+    return ((PincNoneWindow*)windowHandle)->fullscreen;
+}
+
+void pincNonesetWindowFocused(struct WindowBackend* obj, WindowHandle windowHandle, bool focused) {
+    PincNoneWindowBackend* this = (PincNoneWindowBackend*)obj->obj;
+    PincNoneWindow* window = (PincNoneWindow*)windowHandle;
+    if(focused) {
+        this->focusedWindow = window;
+    } else if(this->focusedWindow == window) {
+        this->focusedWindow = 0;
+    }
+}
+
+bool pincNonegetWindowFocused(struct WindowBackend* obj, WindowHandle windowHandle) {
+    PincNoneWindowBackend* this = (PincNoneWindowBackend*)obj->obj;
+    return this->focusedWindow == (PincNoneWindow*)windowHandle;
+}
+
+void pincNonesetWindowHidden(struct WindowBackend* obj, WindowHandle windowHandle, bool hidden) {
+    P_UNUSED(obj);
+    ((PincNoneWindow*)windowHandle)->hidden = hidden;
+}
+
+bool pincNonegetWindowHidden(struct WindowBackend* obj, WindowHandle windowHandle) {
+    P_UNUSED(obj);
+    return ((PincNoneWindow*)windowHandle)->hidden;
+}
+
+PincErrorCode pincNonesetVsync(struct WindowBackend* obj, bool vsync) {
+    PincNoneWindowBackend* this = (PincNoneWindowBackend*)obj->obj;
+    // Nothing to sync to, but it's remembered so it reads back the same
+    this->vsync = vsync;
+    return PincErrorCode_pass;
+}
+
+bool pincNonegetVsync(struct WindowBackend* obj) {
+    PincNoneWindowBackend* this = (PincNoneWindowBackend*)obj->obj;
+    return this->vsync;
+}
+
+void pincNonewindowPresentFramebuffer(struct WindowBackend* obj, WindowHandle windowHandle) {
+    P_UNUSED(obj);
+    PincNoneWindow* window = (PincNoneWindow*)windowHandle;
+    // Like a real swap chain, the new back buffer has whatever was presented two frames ago
+    window->front ^= 1;
+}
+
+void* pincNonewindowGetPixels(struct WindowBackend* obj, WindowHandle windowHandle, uint32_t* outStride) {
+    P_UNUSED(obj);
+    PincNoneWindow* window = (PincNoneWindow*)windowHandle;
+    *outStride = window->stride;
+    if(!window->pixels) {
+        return 0;
+    }
+    return window->pixels + pincNoneWindowBufferSize(window) * (window->front ^ 1);
+}
+
+bool pincNonewindowReadPixels(struct WindowBackend* obj, WindowHandle windowHandle, void* dest, uint32_t destStride) {
+    P_UNUSED(obj);
+    PincNoneWindow* window = (PincNoneWindow*)windowHandle;
+    if(!window->pixels) {
+        return true;
+    }
+    uint8_t const* source = window->pixels + pincNoneWindowBufferSize(window) * window->front;
+    if(destStride == window->stride) {
+        pincMemCopy(source, dest, pincNoneWindowBufferSize(window));
+        return true;
+    }
+    for(uint32_t row=0; row<window->height; ++row) {
+        pincMemCopy(source + (size_t)row * window->stride, (uint8_t*)dest + (size_t)row * destStride, window->stride);
+    }
+    return true;
+}
+
+// The none backend has no OpenGL. The frontend only gets here if the user asks about OpenGL with the none backend explicitly.
+
+PincOpenglSupportStatus pincNonequeryGlVersionSupported(struct WindowBackend* obj, uint32_t major, uint32_t minor, PincOpenglContextProfile profile) {
+    P_UNUSED(obj);
+    P_UNUSED(major);
+    P_UNUSED(minor);
+    P_UNUSED(profile);
+    return PincOpenglSupportStatus_none;
+}
+
+PincOpenglSupportStatus pincNonequeryGlAccumulatorBits(struct WindowBackend* obj, FramebufferFormat framebuffer, uint32_t channel, uint32_t bits) {
+    P_UNUSED(obj);
+    P_UNUSED(framebuffer);
+    P_UNUSED(channel);
+    P_UNUSED(bits);
+    return PincOpenglSupportStatus_none;
+}
+
+PincOpenglSupportStatus pincNonequeryGlAlphaBits(struct WindowBackend* obj, FramebufferFormat framebuffer, uint32_t bits) {
+    P_UNUSED(obj);
+    P_UNUSED(framebuffer);
+    P_UNUSED(bits);
+    return PincOpenglSupportStatus_none;
+}
+
+PincOpenglSupportStatus pincNonequeryGlDepthBits(struct WindowBackend* obj, FramebufferFormat framebuffer, uint32_t bits) {
+    P_UNUSED(obj);
+    P_UNUSED(framebuffer);
+    P_UNUSED(bits);
+    return PincOpenglSupportStatus_none;
+}
+
+PincOpenglSupportStatus pincNonequeryGlStencilBits(struct WindowBackend* obj, FramebufferFormat framebuffer, uint32_t bits) {
+    P_UNUSED(obj);
+    P_UNUSED(framebuffer);
+    P_UNUSED(bits);
+    return PincOpenglSupportStatus_none;
+}
+
+PincOpenglSupportStatus pincNonequeryGlSamples(struct WindowBackend* obj, FramebufferFormat framebuffer, uint32_t samples) {
+    P_UNUSED(obj);
+    P_UNUSED(framebuffer);
+    P_UNUSED(samples);
+    return PincOpenglSupportStatus_none;
+}
+
+PincOpenglSupportStatus pincNonequeryGlStereoBuffer(struct WindowBackend* obj, FramebufferFormat framebuffer) {
+    P_UNUSED(obj);
+    P_UNUSED(framebuffer);
+    return PincOpenglSupportStatus_none;
+}
+
+PincOpenglSupportStatus pincNonequeryGlContextDebug(struct WindowBackend* obj) {
+    P_UNUSED(obj);
+    return PincOpenglSupportStatus_none;
+}
+
+PincOpenglSupportStatus pincNonequeryGlRobustAccess(struct WindowBackend* obj) {
+    P_UNUSED(obj);
+    return PincOpenglSupportStatus_none;
+}
+
+PincOpenglSupportStatus pincNonequeryGlResetIsolation(struct WindowBackend* obj) {
+    P_UNUSED(obj);
+    return PincOpenglSupportStatus_none;
+}
+
+bool pincNoneglProbeResults(struct WindowBackend* obj, GlProbeResults* outResults) {
+    P_UNUSED(obj);
+    P_UNUSED(outResults);
+    return false;
+}
+
+RawOpenglContextHandle pincNoneglCompleteContext(struct WindowBackend* obj, IncompleteGlContext incompleteContext) {
+    P_UNUSED(obj);
+    P_UNUSED(incompleteContext);
+    PincAssertUser(false, "The none window backend does not support OpenGL", true, return 0;);
+    return 0;
+}
+
+void pincNoneglDeinitContext(struct WindowBackend* obj, RawOpenglContextObject context) {
+    // glCompleteContext never makes one
+    P_UNUSED(obj);
+    P_UNUSED(context);
+}
+
+uint32_t pincNoneglGetContextAccumulatorBits(struct WindowBackend* obj, RawOpenglContextObject context, uint32_t channel) {
+    P_UNUSED(obj);
+    P_UNUSED(context);
+    P_UNUSED(channel);
+    return 0;
+}
+
+uint32_t pincNoneglGetContextAlphaBits(struct WindowBackend* obj, RawOpenglContextObject context) {
+    P_UNUSED(obj);
+    P_UNUSED(context);
+    return 0;
+}
+
+uint32_t pincNoneglGetContextDepthBits(struct WindowBackend* obj, RawOpenglContextObject context) {
+    P_UNUSED(obj);
+    P_UNUSED(context);
+    return 0;
+}
+
+uint32_t pincNoneglGetContextStencilBits(struct WindowBackend* obj, RawOpenglContextObject context) {
+    P_UNUSED(obj);
+    P_UNUSED(context);
+    return 0;
+}
+
+uint32_t pincNoneglGetContextSamples(struct WindowBackend* obj, RawOpenglContextObject context) {
+    P_UNUSED(obj);
+    P_UNUSED(context);
+    return 0;
+}
+
+bool pincNoneglGetContextStereoBuffer(struct WindowBackend* obj, RawOpenglContextObject context) {
+    P_UNUSED(obj);
+    P_UNUSED(context);
+    return false;
+}
+
+bool pincNoneglGetContextDebug(struct WindowBackend* obj, RawOpenglContextObject context) {
+    P_UNUSED(obj);
+    P_UNUSED(context);
+    return false;
+}
+
+bool pincNoneglGetContextRobustAccess(struct WindowBackend* obj, RawOpenglContextObject context) {
+    P_UNUSED(obj);
+    P_UNUSED(context);
+    return false;
+}
+
+bool pincNoneglGetContextResetIsolation(struct WindowBackend* obj, RawOpenglContextObject context) {
+    P_UNUSED(obj);
+    P_UNUSED(context);
+    return false;
+}
+
+PincErrorCode pincNoneglMakeCurrent(struct WindowBackend* obj, WindowHandle window, RawOpenglContextHandle context) {
+    P_UNUSED(obj);
+    P_UNUSED(window);
+    P_UNUSED(context);
+    // Making nothing current is fine, there is nothing current to begin with
+    PincAssertUser(context == 0, "The none window backend does not support OpenGL", true, return PincErrorCode_user;);
+    return PincErrorCode_pass;
+}
+
+PincWindowHandle pincNoneglGetCurrentWindow(struct WindowBackend* obj) {
+    P_UNUSED(obj);
+    return 0;
+}
+
+PincOpenglContextHandle pincNoneglGetCurrentContext(struct WindowBackend* obj) {
+    P_UNUSED(obj);
+    return 0;
+}
+
+PincPfn pincNoneglGetProc(struct WindowBackend* obj, char const* procname) {
+    P_UNUSED(obj);
+    P_UNUSED(procname);
+    return 0;
+}
+
+bool pincNoneInit(WindowBackend* obj) {
+    obj->obj = PincAllocator_allocate(categoryAllocator(PincAllocCategory_backend), sizeof(PincNoneWindowBackend));
+    PincNoneWindowBackend* this = (PincNoneWindowBackend*)obj->obj;
+    *this = (PincNoneWindowBackend){0};
+    obj->id = PincWindowBackend_none;
+    // Load all of the functions into the vtable
+    #define PINC_WINDOW_INTERFACE_FUNCTION(type, arguments, name, argumentsNames, defaultReturn) obj->vt.name = pincNone##name;
+    #define PINC_WINDOW_INTERFACE_PROCEDURE(arguments, name, argumentsNames) obj->vt.name = pincNone##name;
+
+    PINC_WINDOW_INTERFACE
+
+    #undef PINC_WINDOW_INTERFACE_FUNCTION
+    #undef PINC_WINDOW_INTERFACE_PROCEDURE
+    return true;
+}
+
+void pincNoneInjectResize(WindowBackend* obj, WindowHandle windowHandle, uint32_t width, uint32_t height) {
+    PincNoneWindowBackend* this = (PincNoneWindowBackend*)obj->obj;
+    PincNoneWindow* window = (PincNoneWindow*)windowHandle;
+    uint32_t oldWidth = window->width;
+    uint32_t oldHeight = window->height;
+    if(oldWidth != width || oldHeight != height) {
+        pincNoneWindowAllocPixels(this, window, width, height);
+    }
+    PincEventResize(pincCurrentTimeMillis(), window->frontHandle, oldWidth, oldHeight, width, height);
+}
+
+void pincNoneInjectFocus(WindowBackend* obj, WindowHandle windowHandle) {
+    PincNoneWindowBackend* this = (PincNoneWindowBackend*)obj->obj;
+    PincNoneWindow* window = (PincNoneWindow*)windowHandle;
+    this->focusedWindow = window;
+    PincEventFocus(pincCurrentTimeMillis(), window ? window->frontHandle : 0);
+}
+
+void pincNoneInjectMouseButton(WindowBackend* obj, uint32_t state) {
+    PincNoneWindowBackend* this = (PincNoneWindowBackend*)obj->obj;
+    uint32_t oldState = this->mouseState;
+    this->mouseState = state;
+    PincEventMouseButton(pincCurrentTimeMillis(), oldState, state);
+}
+
+void pincNoneInjectCursorMove(WindowBackend* obj, WindowHandle windowHandle, uint32_t x, uint32_t y) {
+    PincNoneWindowBackend* this = (PincNoneWindowBackend*)obj->obj;
+    PincNoneWindow* window = (PincNoneWindow*)windowHandle;
+    PincNoneWindow* oldWindow = this->cursorWindow;
+    uint32_t oldX = this->cursorX;
+    uint32_t oldY = this->cursorY;
+    this->cursorWindow = window;
+    this->cursorX = x;
+    this->cursorY = y;
+    if(oldWindow == window) {
+        PincEventCursorMove(pincCurrentTimeMillis(), window->frontHandle, oldX, oldY, x, y);
+    } else if(oldWindow) {
+        PincEventCursorTransition(pincCurrentTimeMillis(), oldWindow->frontHandle, oldX, oldY, window->frontHandle, x, y);
+    } else {
+        // Coming from nowhere
+        PincEventCursorTransition(pincCurrentTimeMillis(), 0, 0, 0, window->frontHandle, x, y);
+    }
+}
+
+void pincNoneSetSynthetic(WindowBackend* obj, PincHeadlessSynthetic kind, WindowHandle window, uint32_t perStep) {
+    PincNoneWindowBackend* this = (PincNoneWindowBackend*)obj->obj;
+    this->synthetic[kind].window = perStep > 0 ? (PincNoneWindow*)window : 0;
+    this->synthetic[kind].perStep = perStep;
+}
+
+#endif
+
+// This is to stop that STUPID empty translation unit error. Why C, why?
+// Not named dummy like SDL2's, since they meet in the unity build.
+struct pincNoneDummy {
+    int d;
+};
@@ -0,0 +1,19 @@
+#include "pinc_window.h"
+#include <stdbool.h>
+
+// The headless window backend. Windows are a pair of pixel buffers in memory, and the only events are the ones the application injects.
+// Nothing to load, so unlike SDL2 there is no separate load step.
+bool pincNoneInit(WindowBackend* obj);
+
+// For the pincHeadlessInject* functions that change what the backend knows about a window, not just send an event.
+// These update the backend's state to match, then send the event.
+void pincNoneInjectResize(WindowBackend* obj, WindowHandle window, uint32_t width, uint32_t height);
+
+void pincNoneInjectFocus(WindowBackend* obj, WindowHandle window);
+
+void pincNoneInjectMouseButton(WindowBackend* obj, uint32_t state);
+
+void pincNoneInjectCursorMove(WindowBackend* obj, WindowHandle window, uint32_t x, uint32_t y);
+
+// See pincHeadlessSetSyntheticEvents. The events are generated in the backend's step.
+void pincNoneSetSynthetic(WindowBackend* obj, PincHeadlessSynthetic kind, WindowHandle window, uint32_t perStep);
@@ -9,6 +9,10 @@
 # define PINC_HAVE_WINDOW_SDL2 1
 #endif
 
+#ifndef PINC_HAVE_WINDOW_NONE
+# define PINC_HAVE_WINDOW_NONE 1
+#endif
+
 #ifndef PINC_ENABLE_ERROR_EXTERNAL
 # define PINC_ENABLE_ERROR_EXTERNAL 1
 #endif
@@ -21,6 +25,36 @@
 # define PINC_ENABLE_ERROR_USER 1
 #endif
 
+#ifndef PINC_ENABLE_ERROR_SANITIZE
+# define PINC_ENABLE_ERROR_SANITIZE 1
+#endif
+
+#ifndef PINC_ENABLE_ERROR_VALIDATE
+# define PINC_ENABLE_ERROR_VALIDATE 0
+#endif
+
 #ifndef PINC_USE_CUSTOM_PLATFORM_IMPLEMENTATION
 # define PINC_USE_CUSTOM_PLATFORM_IMPLEMENTATION 0
 #endif
+
+#ifndef PINC_USE_BUILTIN_MEMORY_FUNCTIONS
+# define PINC_USE_BUILTIN_MEMORY_FUNCTIONS 0
+#endif
+
+#ifndef PINC_SDL2_LINK_DIRECT
+# define PINC_SDL2_LINK_DIRECT 0
+#endif
+
+#ifndef PINC_DIRECT_WINDOW_BACKEND
+# define PINC_DIRECT_WINDOW_BACKEND 1
+#endif
+
+// 0: off, 1: probe on first query, 2: probe everything on a background thread during init
+#ifndef PINC_OPENGL_PROBE
+# define PINC_OPENGL_PROBE 1
+#endif
+
+// 0: debug, 1: info, 2: warn, 3: error, 4: fatal
+#ifndef PINC_LOG_MIN_LEVEL
+# define PINC_LOG_MIN_LEVEL 0
+#endif
@@ -25,13 +25,57 @@
 
 typedef struct {
     SDL_Window* sdlWindow;
+    // The PincSdl2WindowBackend this window belongs to. SDL's windows and events are shared by every Pinc instance in the process.
+    void* backend;
     PincWindowHandle frontHandle;
     uint32_t width;
     uint32_t height;
 } PincSdl2Window;
 
+// Things the OpenGL probe finds out, each one probed separately so a query only pays for what it asks about
+typedef enum {
+    // One for each profile, in the same order as PincOpenglContextProfile
+    PincSdl2GlProbe_versionLegacy,
+    PincSdl2GlProbe_versionCompatibility,
+    PincSdl2GlProbe_versionCore,
+    PincSdl2GlProbe_versionForward,
+    PincSdl2GlProbe_accumulatorBits,
+    PincSdl2GlProbe_alphaBits,
+    PincSdl2GlProbe_depthBits,
+    PincSdl2GlProbe_stencilBits,
+    PincSdl2GlProbe_samples,
+    PincSdl2GlProbe_stereo,
+    PincSdl2GlProbe_debug,
+    PincSdl2GlProbe_robustAccess,
+    PincSdl2GlProbe_resetIsolation,
+    PincSdl2GlProbe_count,
+} PincSdl2GlProbeItem;
+
+// The results have to fit in the capability cache
+typedef char PincSdl2GlProbeFitsInCache[PincSdl2GlProbe_count <= PINC_GL_PROBE_RESULTS_CAPACITY ? 1 : -1];
+
+typedef struct {
+    // Bit for each PincSdl2GlProbeItem that has been probed
+    uint32_t probed;
+    // For versions: one more than the index into pincSdl2GlVersions of the highest one that worked, 0 if none did.
+    // For bits and samples: the highest value that worked, or -1 if not even 0 worked.
+    // For the rest: 1 if it worked, 0 if not.
+    int32_t results[PincSdl2GlProbe_count];
+    // The background probe thread, if there is one
+    void* thread;
+    // A hidden window of the probe thread's own, so it never makes contexts on a window the user could be given (see pincSdl2GetDummyWindow).
+    // Made and destroyed on the main thread, and only there while the thread is. Otherwise probing uses the dummy window.
+    SDL_Window* window;
+    #if PINC_OPENGL_PROBE == 2
+    WindowBackendBackground background;
+    #endif
+} PincSdl2GlProbe;
+
 typedef struct {
+    #if !PINC_SDL2_LINK_DIRECT
+    // Use PincSdl2Lib(this) to call these, which also works when SDL2 is linked directly
     Sdl2Functions libsdl2;
+    #endif
     void* sdl2Lib;
     // May be null.
     PincSdl2Window* dummyWindow;
@@ -44,17 +88,20 @@ typedef struct {
     size_t windowsNum;
     size_t windowsCapacity;
     uint32_t mouseState;
+    PincSdl2GlProbe glProbe;
+    // Whether SDL_Init has been called. Can already be true in pincSdl2Init when the backend was retained, see pincSdl2Retain.
+    bool sdlInitialized;
 } PincSdl2WindowBackend;
 
 // Adds a window to the list of windows
 void pincSdl2AddWindow(PincSdl2WindowBackend* this, PincSdl2Window* window) {
     if(!this->windows) {
-        this->windows = (PincSdl2Window**) PincAllocator_allocate(rootAllocator, sizeof(PincSdl2Window*) * 8);
+        this->windows = (PincSdl2Window**) PincAllocator_allocate(categoryAllocator(PincAllocCategory_backend), sizeof(PincSdl2Window*) * 8);
         this->windowsNum = 0;
         this->windowsCapacity = 8;
     }
     if(this->windowsCapacity == this->windowsNum) {
-        this->windows = (PincSdl2Window**) PincAllocator_reallocate(rootAllocator, (void*) this->windows, sizeof(PincSdl2Window*) * this->windowsCapacity, sizeof(PincSdl2Window*) * this->windowsCapacity * 2);
+        this->windows = (PincSdl2Window**) PincAllocator_reallocate(categoryAllocator(PincAllocCategory_backend), (void*) this->windows, sizeof(PincSdl2Window*) * this->windowsCapacity, sizeof(PincSdl2Window*) * this->windowsCapacity * 2);
         this->windowsCapacity = this->windowsCapacity * 2;
     }
     this->windows[this->windowsNum] = window;
@@ -86,6 +133,7 @@ void pincSdl2RemoveWindow(PincSdl2WindowBackend* this, PincSdl2Window* window) {
     this->windowsNum--;
 }
 
+#if !PINC_SDL2_LINK_DIRECT
 static void* pincSdl2LoadLib(void) {
     // On my Linux mint system with libsdl2-dev installed, I get these:
     // - libSDL2-2.0.so
@@ -98,6 +146,7 @@ static void* pincSdl2LoadLib(void) {
     }
     return lib;
 }
+#endif
 
 static void pincSdl2UnloadLib(void* lib) {
     if(lib) {
@@ -372,38 +421,72 @@ PINC_WINDOW_INTERFACE
 #undef PINC_WINDOW_INTERFACE_FUNCTION
 #undef PINC_WINDOW_INTERFACE_PROCEDURE
 
-bool pincSdl2Init(WindowBackend* obj) {
-    obj->obj = PincAllocator_allocate(rootAllocator, sizeof(PincSdl2WindowBackend));
+static PincSdl2Window* pincSdl2GetDummyWindow(struct WindowBackend* obj);
+#if PINC_OPENGL_PROBE == 2
+static void pincSdl2GlProbeThread(void* arg);
+static void pincSdl2GlProbeWait(struct WindowBackend* obj);
+#endif
+
+bool pincSdl2Load(WindowBackend* obj) {
+    obj->id = PincWindowBackend_sdl2;
+    if(staticState.retained.sdl2Backend) {
+        // Still loaded (and initialized) from the last time around
+        obj->obj = staticState.retained.sdl2Backend;
+        staticState.retained.sdl2Backend = 0;
+        return true;
+    }
+    obj->obj = PincAllocator_allocate(categoryAllocator(PincAllocCategory_backend), sizeof(PincSdl2WindowBackend));
     PincSdl2WindowBackend* this = (PincSdl2WindowBackend*)obj->obj;
     *this = (PincSdl2WindowBackend){0};
+    #if !PINC_SDL2_LINK_DIRECT
+    int64_t loadStart = pincCurrentTimeNanos();
     // The only thing required for SDL2 support is for the SDL2 library to be present
     void* lib = pincSdl2LoadLib();
     if(!lib) {
-        PincLogLiteral("[BACKEND SDL2] [WARN] library could not be loaded, disabling SDL2 backend.");
+        PincLogLiteral(PincLogLevel_warn, "[BACKEND SDL2] [WARN] library could not be loaded, disabling SDL2 backend.");
+        // The frontend goes by whether the object is there to know if the backend is
+        PincAllocator_free(categoryAllocator(PincAllocCategory_backend), this, sizeof(PincSdl2WindowBackend));
+        obj->obj = 0;
         return false;
     }
     this->sdl2Lib = lib;
 
     pincLoadSdl2Functions(this->sdl2Lib, &this->libsdl2);
+    pincStartupPhaseRecord(PincStartupPhase_libraryLoad, loadStart);
+    #endif
+    // When SDL2 is linked directly, it's already there and there is nothing to load
     SDL_version sdlVersion;
-    this->libsdl2.getVersion(&sdlVersion);
-    PincString strings[] = {
-        pincString_makeDirect("[BACKEND SDL2] [TRACE] Loaded SDL2 version: "),
-        pincString_allocFormatUint32(sdlVersion.major, tempAllocator),
-        pincString_makeDirect("."),
-        pincString_allocFormatUint32(sdlVersion.minor, tempAllocator),
-        pincString_makeDirect("."),
-        pincString_allocFormatUint32(sdlVersion.patch, tempAllocator),
-    };
-    PincString msg = pincString_concat(sizeof(strings) / sizeof(PincString), strings, tempAllocator);
-    PincLogStr(msg);
+    PincSdl2Lib(this).getVersion(&sdlVersion);
+    if(PincLogEnabled(PincLogLevel_debug)) {
+        PincString strings[] = {
+            pincString_makeDirect("[BACKEND SDL2] [TRACE] Loaded SDL2 version: "),
+            pincString_allocFormatUint32(sdlVersion.major, tempAllocator),
+            pincString_makeDirect("."),
+            pincString_allocFormatUint32(sdlVersion.minor, tempAllocator),
+            pincString_makeDirect("."),
+            pincString_allocFormatUint32(sdlVersion.patch, tempAllocator),
+        };
+        PincString msg = pincString_concat(sizeof(strings) / sizeof(PincString), strings, tempAllocator);
+        PincLogStr(PincLogLevel_debug, msg);
+    }
     if(sdlVersion.major < 2) {
-        PincLogLiteral("[BACKEND SDL2] [WARN] version too old, disabling SDL2 backend");
-        this->sdl2Lib = 0;
-        this->libsdl2 = (Sdl2Functions){0};
+        PincLogLiteral(PincLogLevel_warn, "[BACKEND SDL2] [WARN] version too old, disabling SDL2 backend");
+        pincSdl2UnloadLib(this->sdl2Lib);
+        PincAllocator_free(categoryAllocator(PincAllocCategory_backend), this, sizeof(PincSdl2WindowBackend));
+        obj->obj = 0;
         return false;
     }
-    this->libsdl2.init(SDL_INIT_VIDEO | SDL_INIT_EVENTS);
+    return true;
+}
+
+bool pincSdl2Init(WindowBackend* obj) {
+    PincSdl2WindowBackend* this = (PincSdl2WindowBackend*)obj->obj;
+    if(!this->sdlInitialized) {
+        int64_t initStart = pincCurrentTimeNanos();
+        PincSdl2Lib(this).init(SDL_INIT_VIDEO | SDL_INIT_EVENTS);
+        pincStartupPhaseRecord(PincStartupPhase_backendInit, initStart);
+        this->sdlInitialized = true;
+    }
     // Load all of the functions into the vtable
     #define PINC_WINDOW_INTERFACE_FUNCTION(type, arguments, name, argumentsNames, defaultReturn) obj->vt.name = pincSdl2##name;
     #define PINC_WINDOW_INTERFACE_PROCEDURE(arguments, name, argumentsNames) obj->vt.name = pincSdl2##name;
@@ -412,6 +495,11 @@ bool pincSdl2Init(WindowBackend* obj) {
 
     #undef PINC_WINDOW_INTERFACE_FUNCTION
     #undef PINC_WINDOW_INTERFACE_PROCEDURE
+
+    #if PINC_OPENGL_PROBE == 2
+    // Background probing starts in pincSdl2glProbeStart, once the frontend has had a chance to say what's cached
+    obj->background = &this->glProbe.background;
+    #endif
     return true;
 }
 
@@ -432,7 +520,7 @@ static PincSdl2Window* pincSdl2GetDummyWindow(struct WindowBackend* obj) {
     }
     char const* const title = "Pinc Dummy Window";
     size_t const titleLen = pincStringLen(title);
-    uint8_t* titlePtr = PincAllocator_allocate(rootAllocator, titleLen);
+    uint8_t* titlePtr = PincAllocator_allocate(categoryAllocator(PincAllocCategory_string), titleLen);
     pincMemCopy(title, titlePtr, titleLen);
     IncompleteWindow windowSettings = {
         // Ownership is transferred to the window
@@ -455,33 +543,62 @@ static PincSdl2Window* pincSdl2GetDummyWindow(struct WindowBackend* obj) {
     return this->dummyWindow;
 }
 
-// Quick function for convenience
-static void pincSdl2FramebufferFormatAdd(FramebufferFormat** formats, size_t* formatsNum, size_t* formatsCapacity, FramebufferFormat const* fmt) {
-    for(size_t formatid=0; formatid<(*formatsNum); formatid++) {
-        FramebufferFormat format = (*formats)[formatid];
-        if(format.color_space != fmt->color_space) {
-            continue;
-        }
-        if(format.channels != fmt->channels) {
-            continue;
-        }
-        if(format.channel_bits[0] != fmt->channel_bits[0]) {
-            continue;
-        }
-        if(format.channels >= 2 && format.channel_bits[1] != fmt->channel_bits[1]) {
-            continue;
-        }
-        if(format.channels >= 3 && format.channel_bits[2] != fmt->channel_bits[2]) {
-            continue;
+// Set of framebuffer formats that have been seen, packed into a single integer each.
+// Open addressing with linear probing. 0 is an empty slot, which is never a real format since those have at least one channel.
+typedef struct {
+    uint64_t* keys;
+    // Always a power of 2
+    size_t capacity;
+    size_t num;
+} PincSdl2FormatSet;
+
+static uint64_t pincSdl2FramebufferFormatKey(FramebufferFormat const* fmt) {
+    // Channel bits only go up to 32 or so, a byte each is plenty
+    uint64_t key = ((uint64_t)fmt->color_space << 40) | ((uint64_t)fmt->channels << 32);
+    for(uint32_t channel=0; channel<4 && channel<fmt->channels; ++channel) {
+        key |= (uint64_t)(fmt->channel_bits[channel] & 0xFF) << (24 - (channel * 8));
+    }
+    return key;
+}
+
+// Returns true if the key was not in the set already
+static bool pincSdl2FormatSetInsert(PincSdl2FormatSet* set, uint64_t key) {
+    if((set->num + 1) * 2 > set->capacity) {
+        // Keep it at most half full, so probe sequences stay short
+        PincSdl2FormatSet newSet = {
+            .keys = PincAllocator_allocate(tempAllocator, sizeof(uint64_t) * set->capacity * 2),
+            .capacity = set->capacity * 2,
+            .num = 0,
+        };
+        pincMemSet(0, newSet.keys, sizeof(uint64_t) * newSet.capacity);
+        for(size_t i=0; i<set->capacity; ++i) {
+            if(set->keys[i]) {
+                pincSdl2FormatSetInsert(&newSet, set->keys[i]);
+            }
         }
-        if(format.channels >= 4 && format.channel_bits[3] != fmt->channel_bits[3]) {
-            continue;
+        PincAllocator_free(tempAllocator, set->keys, sizeof(uint64_t) * set->capacity);
+        *set = newSet;
+    }
+    // Fibonacci hashing, the low bits of the key are not very random on their own
+    size_t index = (size_t)((key * UINT64_C(0x9E3779B97F4A7C15)) >> 32) & (set->capacity - 1);
+    while(set->keys[index]) {
+        if(set->keys[index] == key) {
+            return false;
         }
+        index = (index + 1) & (set->capacity - 1);
+    }
+    set->keys[index] = key;
+    set->num++;
+    return true;
+}
+
+// Quick function for convenience
+static void pincSdl2FramebufferFormatAdd(FramebufferFormat** formats, size_t* formatsNum, size_t* formatsCapacity, PincSdl2FormatSet* seen, FramebufferFormat const* fmt) {
+    if(!pincSdl2FormatSetInsert(seen, pincSdl2FramebufferFormatKey(fmt))) {
         // This format is already in the list, don't add it again
         return;
-
     }
-    if(formatsNum == formatsCapacity) {
+    if(*formatsNum == *formatsCapacity) {
         size_t newFormatsCapacity = *formatsCapacity*2;
         *formats = PincAllocator_reallocate(tempAllocator, *formats, sizeof(FramebufferFormat) * (*formatsCapacity), sizeof(FramebufferFormat) * newFormatsCapacity);
         *formatsCapacity = newFormatsCapacity;
@@ -502,39 +619,38 @@ FramebufferFormat* pincSdl2queryFramebufferFormats(struct WindowBackend* obj, Pi
     // Ideally, SDL2 would report the list of Visuals from X or the list of pixel formats from win32, but this is the next best option
 
     // Dynamic list to hold the framebuffer formats
-    // TODO(bluesillybeard): A proper set data structure for deduplication is a good idea
     FramebufferFormat* formats = PincAllocator_allocate(tempAllocator, sizeof(FramebufferFormat)*8);
     size_t formatsNum = 0;
     size_t formatsCapacity = 8;
+    // There are generally a lot more display modes than there are distinct formats among them
+    PincSdl2FormatSet seen = {
+        .keys = PincAllocator_allocate(tempAllocator, sizeof(uint64_t) * 16),
+        .capacity = 16,
+        .num = 0,
+    };
+    pincMemSet(0, seen.keys, sizeof(uint64_t) * seen.capacity);
 
-    int numDisplays = this->libsdl2.getNumVideoDisplays();
+    int numDisplays = PincSdl2Lib(this).getNumVideoDisplays();
     if(numDisplays < 0) {
-        PincString strings[] = {
-            pincString_makeDirect("Pinc encountered fatal SDL2 error: "),
-            pincString_makeDirect((char*)this->libsdl2.getError()),
-        };
-        PincString err = pincString_concat(sizeof(strings) / sizeof(PincString), strings, tempAllocator);
         *outNumFormats = 0;
-        pincInternalCallError(err, PincErrorCode_external, false);
+        pincInternalCallErrorDetail("Pinc encountered fatal SDL2 error: ", PincSdl2Lib(this).getError(), PincErrorCode_external, false);
         return NULL;
     }
     for(int displayIndex=0; displayIndex<numDisplays; ++displayIndex) {
-        int numDisplayModes = this->libsdl2.getNumDisplayModes(displayIndex);
+        int numDisplayModes = PincSdl2Lib(this).getNumDisplayModes(displayIndex);
         if(numDisplayModes < 0) {
-            PincString strings[] = {
-                pincString_makeDirect("Pinc encountered fatal SDL2 error: "),
-                pincString_makeDirect((char*)this->libsdl2.getError()),
-            };
-            PincString err = pincString_concat(sizeof(strings) / sizeof(PincString), strings, tempAllocator);
             *outNumFormats = 0;
-            pincInternalCallError(err, PincErrorCode_external, false);
+            pincInternalCallErrorDetail("Pinc encountered fatal SDL2 error: ", PincSdl2Lib(this).getError(), PincErrorCode_external, false);
             return NULL;
         }
         for(int displayModeIndex=0; displayModeIndex<numDisplayModes; ++displayModeIndex) {
             SDL_DisplayMode displayMode;
-            this->libsdl2.getDisplayMode(displayIndex, displayModeIndex, &displayMode);
+            PincSdl2Lib(this).getDisplayMode(displayIndex, displayModeIndex, &displayMode);
             // Strangeness is going on and I don't like it!
             if(!displayMode.format || !displayMode.w || !displayMode.h) {
+                if(!PincLogEnabled(PincLogLevel_warn)) {
+                    continue;
+                }
                 PincString strings[] = {
                     pincString_makeDirect("[BACKEND SDL2] [WARN] Invalid display mode "),
                     pincString_allocFormatUint64((uint64_t)displayModeIndex, tempAllocator),
@@ -542,7 +658,7 @@ FramebufferFormat* pincSdl2queryFramebufferFormats(struct WindowBackend* obj, Pi
                     pincString_allocFormatUint64((uint64_t)displayIndex, tempAllocator),
                 };
                 PincString err = pincString_concat(sizeof(strings) / sizeof(PincString), strings, tempAllocator);
-                PincLogStr(err);
+                PincLogStr(PincLogLevel_warn, err);
                 pincString_free(&err, tempAllocator);
                 continue;
             }
@@ -552,13 +668,16 @@ FramebufferFormat* pincSdl2queryFramebufferFormats(struct WindowBackend* obj, Pi
             uint32_t gmask = 0;
             uint32_t bmask = 0;
             uint32_t amask = 0;
-            if(this->libsdl2.pixelFormatEnumToMasks(displayMode.format, &bpp, &rmask, &gmask, &bmask, &amask) == SDL_FALSE){
+            if(PincSdl2Lib(this).pixelFormatEnumToMasks(displayMode.format, &bpp, &rmask, &gmask, &bmask, &amask) == SDL_FALSE){
+                if(!PincLogEnabled(PincLogLevel_warn)) {
+                    continue;
+                }
                 PincString strings[] = {
                     pincString_makeDirect("[BACKEND SDL2] [WARN] Pinc encountered an SDL2 error: "),
-                    pincString_makeDirect((char*)this->libsdl2.getError()),
+                    pincString_makeDirect((char*)PincSdl2Lib(this).getError()),
                 };
                 PincString err = pincString_concat(sizeof(strings) / sizeof(PincString), strings, tempAllocator);
-                PincLogStr(err);
+                PincLogStr(PincLogLevel_warn, err);
                 pincString_free(&err, tempAllocator);
                 continue;
             }
@@ -585,7 +704,7 @@ FramebufferFormat* pincSdl2queryFramebufferFormats(struct WindowBackend* obj, Pi
                 bufferFormat.channels = 4;
                 bufferFormat.channel_bits[3] = bitCount32(amask);
             }
-            pincSdl2FramebufferFormatAdd(&formats, &formatsNum, &formatsCapacity, &bufferFormat);
+            pincSdl2FramebufferFormatAdd(&formats, &formatsNum, &formatsCapacity, &seen, &bufferFormat);
         }
     }
     // Allocate the final returned value
@@ -595,6 +714,7 @@ FramebufferFormat* pincSdl2queryFramebufferFormats(struct WindowBackend* obj, Pi
     }
     // Even though the temp allocator os a bump allocator, we may as well treat it as a real one.
     PincAllocator_free(tempAllocator, formats, formatsCapacity * sizeof(FramebufferFormat));
+    PincAllocator_free(tempAllocator, seen.keys, seen.capacity * sizeof(uint64_t));
     *outNumFormats = formatsNum;
     return actualFormats;
 }
@@ -609,6 +729,52 @@ bool pincSdl2queryGraphicsApiSupport(struct WindowBackend* obj, PincGraphicsApi
     }
 }
 
+static P_INLINE uint64_t pincSdl2HashMix(uint64_t hash, uint32_t value) {
+    return (hash ^ value) * UINT64_C(0x100000001B3);
+}
+
+uint64_t pincSdl2queryConfigurationHash(struct WindowBackend* obj) {
+    PincSdl2WindowBackend* this = (PincSdl2WindowBackend*)obj->obj;
+    // The available formats come from the display modes, which depend on the SDL version and what displays are connected.
+    // Every mode of every display goes in, since a display can gain or lose modes without its current mode changing.
+    // SDL keeps the mode list after the first time it's asked, so this only reads it. What the cache saves is turning each mode into a format and deduplicating them.
+    SDL_version sdlVersion;
+    PincSdl2Lib(this).getVersion(&sdlVersion);
+    uint64_t hash = UINT64_C(0xcbf29ce484222325);
+    hash = pincSdl2HashMix(hash, ((uint32_t)sdlVersion.major << 16) | ((uint32_t)sdlVersion.minor << 8) | (uint32_t)sdlVersion.patch);
+    int numDisplays = PincSdl2Lib(this).getNumVideoDisplays();
+    if(numDisplays < 0) {
+        return 0;
+    }
+    hash = pincSdl2HashMix(hash, (uint32_t)numDisplays);
+    for(int displayIndex=0; displayIndex<numDisplays; ++displayIndex) {
+        SDL_DisplayMode mode;
+        if(PincSdl2Lib(this).getDesktopDisplayMode(displayIndex, &mode) != 0) {
+            return 0;
+        }
+        hash = pincSdl2HashMix(hash, mode.format);
+        hash = pincSdl2HashMix(hash, (uint32_t)mode.w);
+        hash = pincSdl2HashMix(hash, (uint32_t)mode.h);
+        hash = pincSdl2HashMix(hash, (uint32_t)mode.refresh_rate);
+        int numDisplayModes = PincSdl2Lib(this).getNumDisplayModes(displayIndex);
+        if(numDisplayModes < 0) {
+            return 0;
+        }
+        hash = pincSdl2HashMix(hash, (uint32_t)numDisplayModes);
+        for(int displayModeIndex=0; displayModeIndex<numDisplayModes; ++displayModeIndex) {
+            if(PincSdl2Lib(this).getDisplayMode(displayIndex, displayModeIndex, &mode) != 0) {
+                return 0;
+            }
+            hash = pincSdl2HashMix(hash, mode.format);
+            hash = pincSdl2HashMix(hash, (uint32_t)mode.w);
+            hash = pincSdl2HashMix(hash, (uint32_t)mode.h);
+            hash = pincSdl2HashMix(hash, (uint32_t)mode.refresh_rate);
+        }
+    }
+    // 0 means "don't know"
+    return hash ? hash : 1;
+}
+
 uint32_t pincSdl2queryMaxOpenWindows(struct WindowBackend* obj) {
     P_UNUSED(obj);
     // SDL2 has no (arbitrary) limit on how many windows can be open.
@@ -617,7 +783,7 @@ uint32_t pincSdl2queryMaxOpenWindows(struct WindowBackend* obj) {
 
 PincErrorCode pincSdl2completeInit(struct WindowBackend* obj, PincGraphicsApi graphicsBackend, FramebufferFormat framebuffer) {
     PincSdl2WindowBackend* this = (PincSdl2WindowBackend*)obj->obj;
-    this->libsdl2.startTextInput();
+    PincSdl2Lib(this).startTextInput();
     P_UNUSED(framebuffer);
     switch (graphicsBackend) //NOLINT: more cases will be added over time
     {
@@ -638,13 +804,62 @@ void pincSdl2deinit(struct WindowBackend* obj) {
     // Make sure the frontend deleted all of the windows already
     PincAssertAssert(this->windowsNum == 0, "Internal pinc error: the frontend didn't delete the windows before calling backend deinit", false, return;);
     
-    this->libsdl2.destroyWindow(this->dummyWindow->sdlWindow);
-    PincAllocator_free(rootAllocator, this->dummyWindow, sizeof(PincSdl2Window));
+    // There is no dummy window if the backend was never used for anything
+    if(this->dummyWindow) {
+        PincSdl2Lib(this).destroyWindow(this->dummyWindow->sdlWindow);
+        PincAllocator_free(categoryAllocator(PincAllocCategory_backend), this->dummyWindow, sizeof(PincSdl2Window));
+    }
 
-    this->libsdl2.quit();
+    // Not SDL_Quit, since another Pinc instance may still be using SDL. SDL counts how many times each subsystem was initialized.
+    // A backend that was only loaded never got that far.
+    if(this->sdlInitialized) {
+        PincSdl2Lib(this).quitSubSystem(SDL_INIT_VIDEO | SDL_INIT_EVENTS);
+    }
     pincSdl2UnloadLib(this->sdl2Lib);
-    PincAllocator_free(rootAllocator, (void*)this->windows, sizeof(PincSdl2Window*) * this->windowsCapacity);
-    PincAllocator_free(rootAllocator, this, sizeof(PincSdl2WindowBackend));
+    PincAllocator_free(categoryAllocator(PincAllocCategory_backend), (void*)this->windows, sizeof(PincSdl2Window*) * this->windowsCapacity);
+    PincAllocator_free(categoryAllocator(PincAllocCategory_backend), this, sizeof(PincSdl2WindowBackend));
+}
+
+void pincSdl2deinitFast(struct WindowBackend* obj) {
+    PincSdl2WindowBackend* this = (PincSdl2WindowBackend*)obj->obj;
+    if(!this->sdlInitialized) {
+        return;
+    }
+    // Quitting the subsystems would destroy the windows too, but only if no other Pinc instance is still using SDL
+    bool dummyListed = false;
+    for(size_t i=0; i<this->windowsNum; ++i) {
+        dummyListed = dummyListed || this->windows[i] == this->dummyWindow;
+        PincSdl2Lib(this).destroyWindow(this->windows[i]->sdlWindow);
+    }
+    if(this->dummyWindow && !dummyListed) {
+        PincSdl2Lib(this).destroyWindow(this->dummyWindow->sdlWindow);
+    }
+    // Not SDL_Quit, for the same reason as pincSdl2deinit
+    PincSdl2Lib(this).quitSubSystem(SDL_INIT_VIDEO | SDL_INIT_EVENTS);
+}
+
+void* pincSdl2Retain(WindowBackend* obj) {
+    PincSdl2WindowBackend* this = (PincSdl2WindowBackend*)obj->obj;
+    PincAssertAssert(this->windowsNum == 0, "Internal pinc error: the frontend didn't delete the windows before retaining the backend", false, return 0;);
+    // Everything that is loaded, initialized, or probed stays. That includes the (hidden) dummy window.
+    // Events are for the windows from this time around, so they are of no use to the next.
+    if(this->sdlInitialized) {
+        PincSdl2Lib(this).flushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+    }
+    this->mouseState = 0;
+    return this;
+}
+
+// SDL has one event queue for the whole process, so one Pinc instance can pull out events meant for another instance's windows.
+// Those are put back once the poll loop is done, for the other instance to get on its own step.
+#define PINC_SDL2_FOREIGN_EVENTS_CAPACITY 64
+
+static void pincSdl2KeepForeignEvent(SDL_Event* foreign, uint32_t* foreignNum, SDL_Event const* event) {
+    // Past the capacity they are dropped. That's only going to happen with a flood of mouse motion, which can spare a few.
+    if(*foreignNum < PINC_SDL2_FOREIGN_EVENTS_CAPACITY) {
+        foreign[*foreignNum] = *event;
+        *foreignNum += 1;
+    }
 }
 
 void pincSdl2step(struct WindowBackend* obj) { //NOLINT: TODO: Fix this abominably massive function. I'm still undecided on the best way to do this.
@@ -652,19 +867,25 @@ void pincSdl2step(struct WindowBackend* obj) { //NOLINT: TODO: Fix this abominab
 
     // The offset between SDL2's getTicks() and platform's pCurrentTimeMillis()
     // so that getTicks + timeOffset == pCurrentTimeMillis() (with some margin of error)
-    int64_t timeOffset = pincCurrentTimeMillis() - ((int64_t)this->libsdl2.getTicks64());
+    int64_t timeOffset = pincCurrentTimeMillis() - ((int64_t)PincSdl2Lib(this).getTicks64());
 
+    SDL_Event foreign[PINC_SDL2_FOREIGN_EVENTS_CAPACITY];
+    uint32_t foreignNum = 0;
     SDL_Event event;
-    while(this->libsdl2.pollEvent(&event)) {
+    while(PincSdl2Lib(this).pollEvent(&event)) {
         int64_t timestamp = (int64_t)event.common.timestamp + timeOffset;
         switch (event.type) {
             case SDL_WINDOWEVENT: {
-                SDL_Window* sdlWin = this->libsdl2.getWindowFromId(event.window.windowID);
+                SDL_Window* sdlWin = PincSdl2Lib(this).getWindowFromId(event.window.windowID);
                 // External -> caused by SDL2 giving us events for nonexistent windows
                 PincAssertExternal(sdlWin, "SDL2 window from WindowEvent is NULL!", true, return;);
-                PincSdl2Window* windowObj = (PincSdl2Window*)this->libsdl2.getWindowData(sdlWin, "pincSdl2Window");
+                PincSdl2Window* windowObj = (PincSdl2Window*)PincSdl2Lib(this).getWindowData(sdlWin, "pincSdl2Window");
                 // Assert -> caused by Pinc not setting the window event data (supposedly)
                 PincAssertAssert(windowObj, "Pinc SDL2 window object from WindowEvent is NULL!", false, return;);
+                if(windowObj->backend != this) {
+                    pincSdl2KeepForeignEvent(foreign, &foreignNum, &event);
+                    break;
+                }
                 switch (event.window.event) {
                     case SDL_WINDOWEVENT_CLOSE:{
                         PincEventCloseSignal(timestamp, windowObj->frontHandle);
@@ -763,12 +984,16 @@ void pincSdl2step(struct WindowBackend* obj) { //NOLINT: TODO: Fix this abominab
                 break;
             }
             case SDL_MOUSEMOTION: {
-                SDL_Window* sdlWin = this->libsdl2.getWindowFromId(event.window.windowID);
+                SDL_Window* sdlWin = PincSdl2Lib(this).getWindowFromId(event.window.windowID);
                 // External -> caused by SDL2 giving us events for nonexistent windows
                 PincAssertExternal(sdlWin, "SDL2 window from WindowEvent is NULL!", true, return;);
-                PincSdl2Window* windowObj = (PincSdl2Window*)this->libsdl2.getWindowData(sdlWin, "pincSdl2Window");
+                PincSdl2Window* windowObj = (PincSdl2Window*)PincSdl2Lib(this).getWindowData(sdlWin, "pincSdl2Window");
                 // Assert -> caused by Pinc not setting the window event data (supposedly)
                 PincAssertAssert(windowObj, "Pinc SDL2 window object from WindowEvent is NULL!", false, return;);
+                if(windowObj->backend != this) {
+                    pincSdl2KeepForeignEvent(foreign, &foreignNum, &event);
+                    break;
+                }
                 // TODO(bluesillybeard): make sure the window that has the cursor is actually the window that SDL2 gave us
                 int32_t motion_x = event.motion.x;
                 int32_t motion_y = event.motion.y;
@@ -801,7 +1026,7 @@ void pincSdl2step(struct WindowBackend* obj) { //NOLINT: TODO: Fix this abominab
                 }
                 // Gotta love backwards compatibility
                 SDL_version sdlVersion;
-                this->libsdl2.getVersion(&sdlVersion);
+                PincSdl2Lib(this).getVersion(&sdlVersion);
                 if(sdlVersion.minor > 2 || (sdlVersion.minor == 2 && sdlVersion.patch >= 18)) {
                     xMovement += event.wheel.preciseX;
                     yMovement += event.wheel.preciseY;
@@ -814,8 +1039,8 @@ void pincSdl2step(struct WindowBackend* obj) { //NOLINT: TODO: Fix this abominab
                 // When VSCode is open, as much as selecting some text will cause it to spam this function with the current clipboard
                 // Or more accurately, system events are rather chaotic so often things get doubled along the way
                 // It's an absolute non-issue, but something worth noting here.
-                if(this->libsdl2.hasClipboardText()) {
-                    char* clipboardText = this->libsdl2.getClipboardText();
+                if(PincSdl2Lib(this).hasClipboardText()) {
+                    char* clipboardText = PincSdl2Lib(this).getClipboardText();
                     PincAssertExternal(clipboardText, "SDL2 clipboard is NULL", true, return;);
                     if(!clipboardText) { break; }
                     size_t clipboardTextLen = pincStringLen(clipboardText);
@@ -855,11 +1080,15 @@ void pincSdl2step(struct WindowBackend* obj) { //NOLINT: TODO: Fix this abominab
             }
         }
     }
+    for(uint32_t i=0; i<foreignNum; ++i) {
+        PincSdl2Lib(this).pushEvent(&foreign[i]);
+    }
 }
 
 WindowHandle pincSdl2completeWindow(struct WindowBackend* obj, IncompleteWindow const * incomplete, PincWindowHandle frontHandle) { //NOLINT: TODO: this function is a mess, rewrite it to be better
     PincSdl2WindowBackend* this = (PincSdl2WindowBackend*)obj->obj;
-    this->libsdl2.resetHints();
+    int64_t start = pincCurrentTimeNanos();
+    PincSdl2Lib(this).resetHints();
 
     uint32_t realWidth = incomplete->width;
     uint32_t realHeight = incomplete->height;
@@ -912,7 +1141,7 @@ WindowHandle pincSdl2completeWindow(struct WindowBackend* obj, IncompleteWindow
 
     if(!this->dummyWindowInUse && this->dummyWindow) {
         PincSdl2Window* dummyWindow = this->dummyWindow;
-        uint32_t realFlags = this->libsdl2.getWindowFlags(dummyWindow->sdlWindow);
+        uint32_t realFlags = PincSdl2Lib(this).getWindowFlags(dummyWindow->sdlWindow);
 
         // If we need opengl but the dummy window doesn't have it,
         // Then, as long as Pinc doesn't start supporting a different graphics api for each window,
@@ -921,8 +1150,8 @@ WindowHandle pincSdl2completeWindow(struct WindowBackend* obj, IncompleteWindow
         // TODO(bluesillybeard) clang-tidy doesn't complain about this, but this if statement is hard to read
         // In fact, a lof of these if statements are difficult to parse
         if((windowFlags&(uint32_t)SDL_WINDOW_OPENGL) && !(realFlags&(uint32_t)SDL_WINDOW_OPENGL)) {
-            this->libsdl2.destroyWindow(dummyWindow->sdlWindow);
-            PincAllocator_free(rootAllocator, dummyWindow, sizeof(PincSdl2Window));
+            PincSdl2Lib(this).destroyWindow(dummyWindow->sdlWindow);
+            PincAllocator_free(categoryAllocator(PincAllocCategory_backend), dummyWindow, sizeof(PincSdl2Window));
             goto SDL_MAKE_NEW_WINDOW;
         }
 
@@ -952,12 +1181,13 @@ WindowHandle pincSdl2completeWindow(struct WindowBackend* obj, IncompleteWindow
         pincSdl2setWindowHeight(obj, this->dummyWindow, realHeight);
 
         char* titleNullTerm = pincString_marshalAlloc(incomplete->title, tempAllocator);
-        this->libsdl2.setWindowTitle(dummyWindow->sdlWindow, titleNullTerm);
+        PincSdl2Lib(this).setWindowTitle(dummyWindow->sdlWindow, titleNullTerm);
         PincAllocator_free(tempAllocator, titleNullTerm, incomplete->title.len+1);
         dummyWindow->frontHandle = frontHandle;
         // They gave us ownership
         // Sooner or later I'm going to change that
-        pincString_free((PincString*)&incomplete->title, rootAllocator);
+        pincString_free((PincString*)&incomplete->title, categoryAllocator(PincAllocCategory_string));
+        pincStartupPhaseRecord(PincStartupPhase_windowComplete, start);
         return dummyWindow;
     }
     SDL_MAKE_NEW_WINDOW:
@@ -968,14 +1198,15 @@ WindowHandle pincSdl2completeWindow(struct WindowBackend* obj, IncompleteWindow
         // (How come nobody ever makes options for those using non null-terminated strings?)
         // Reminder: SDL2 uses UTF8 encoding for pretty much all strings
         char* titleNullTerm = pincString_marshalAlloc(incomplete->title, tempAllocator);
-        SDL_Window* win = this->libsdl2.createWindow(titleNullTerm, SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, (int)realWidth, (int)realHeight, windowFlags); //NOLINT: we do not have control over SDL macros
+        SDL_Window* win = PincSdl2Lib(this).createWindow(titleNullTerm, SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, (int)realWidth, (int)realHeight, windowFlags); //NOLINT: we do not have control over SDL macros
         // I'm so paranoid, I actually went through the SDL2 source code to make sure it actually duplicates the window title to avoid a use-after-free
         // Better too worried than not enough I guess
         PincAllocator_free(tempAllocator, titleNullTerm, incomplete->title.len+1);
 
-        PincSdl2Window* windowObj = PincAllocator_allocate(rootAllocator, sizeof(PincSdl2Window));
+        PincSdl2Window* windowObj = PincAllocator_allocate(categoryAllocator(PincAllocCategory_backend), sizeof(PincSdl2Window));
         *windowObj = (PincSdl2Window){
             .sdlWindow = win,
+            .backend = this,
             .frontHandle = frontHandle,
             .width = realWidth,
             .height = realHeight,
@@ -983,10 +1214,10 @@ WindowHandle pincSdl2completeWindow(struct WindowBackend* obj, IncompleteWindow
         
         // They gave us ownership
         // Sooner or later I'm going to change that
-        pincString_free((PincString*)&incomplete->title, rootAllocator);
+        pincString_free((PincString*)&incomplete->title, categoryAllocator(PincAllocCategory_string));
 
         // So we can easily get one of our windows out of the SDL2 window handle
-        this->libsdl2.setWindowData(win, "pincSdl2Window", windowObj);
+        PincSdl2Lib(this).setWindowData(win, "pincSdl2Window", windowObj);
 
         // Add it to the list of windows
         pincSdl2AddWindow(this, windowObj);
@@ -996,6 +1227,10 @@ WindowHandle pincSdl2completeWindow(struct WindowBackend* obj, IncompleteWindow
             this->dummyWindow = windowObj;
             this->dummyWindowInUse = true;
         }
+        // The dummy window the backend makes for itself (with no front handle) is not the application's first window
+        if(frontHandle) {
+            pincStartupPhaseRecord(PincStartupPhase_windowComplete, start);
+        }
         return (WindowHandle)windowObj;
     }
 }
@@ -1003,7 +1238,7 @@ WindowHandle pincSdl2completeWindow(struct WindowBackend* obj, IncompleteWindow
 void pincSdl2deinitWindow(struct WindowBackend* obj, WindowHandle windowHandle) {
     PincSdl2WindowBackend* this = (PincSdl2WindowBackend*)obj->obj;
     PincSdl2Window* window = (PincSdl2Window*)windowHandle;
-    #if PINC_ENABLE_ERROR_VALIDATE
+    #if PINC_ENABLE_ERROR_VALIDATE && PINC_ENABLE_ERROR_ASSERT
     bool dummyWindowActuallyInUse = false;
     for(size_t i=0; i<this->windowsNum; ++i) {
         PincSdl2Window* windowToCheck = this->windows[i];
@@ -1011,7 +1246,7 @@ void pincSdl2deinitWindow(struct WindowBackend* obj, WindowHandle windowHandle)
             dummyWindowActuallyInUse = true;
         }
     }
-    PErrorValidate(dummyWindowActuallyInUse == this->dummyWindowInUse, "Dummy window in use does not match reality");
+    PincAssertAssert(dummyWindowActuallyInUse == this->dummyWindowInUse, "Dummy window in use does not match reality", true, {});
     #endif
     pincSdl2RemoveWindow(this, window);
     if(window == this->dummyWindow) {
@@ -1019,8 +1254,8 @@ void pincSdl2deinitWindow(struct WindowBackend* obj, WindowHandle windowHandle)
         this->dummyWindowInUse = false;
         return;
     }
-    this->libsdl2.destroyWindow(window->sdlWindow);
-    PincAllocator_free(rootAllocator, window, sizeof(PincSdl2Window));
+    PincSdl2Lib(this).destroyWindow(window->sdlWindow);
+    PincAllocator_free(categoryAllocator(PincAllocCategory_backend), window, sizeof(PincSdl2Window));
 }
 
 void pincSdl2setWindowTitle(struct WindowBackend* obj, WindowHandle windowHandle, uint8_t* title, size_t titleLen) {
@@ -1029,16 +1264,16 @@ void pincSdl2setWindowTitle(struct WindowBackend* obj, WindowHandle windowHandle
     
     // It needs to be null terminated because reasons
     char* titleNullTerm = pincString_marshalAlloc((PincString){.str = title, .len = titleLen}, tempAllocator);
-    this->libsdl2.setWindowTitle(window->sdlWindow, titleNullTerm);
+    PincSdl2Lib(this).setWindowTitle(window->sdlWindow, titleNullTerm);
     PincAllocator_free(tempAllocator, titleNullTerm, titleLen+1);
     // We take ownership of the title
-    PincAllocator_free(rootAllocator, title, titleLen);
+    PincAllocator_free(categoryAllocator(PincAllocCategory_string), title, titleLen);
 }
 
 uint8_t const * pincSdl2getWindowTitle(struct WindowBackend* obj, WindowHandle windowHandle, size_t* outTitleLen) {
     PincSdl2WindowBackend* this = (PincSdl2WindowBackend*)obj->obj;
     PincSdl2Window* window = (PincSdl2Window*)windowHandle;
-    char const* title = this->libsdl2.getWindowTitle(window->sdlWindow);
+    char const* title = PincSdl2Lib(this).getWindowTitle(window->sdlWindow);
     *outTitleLen = pincStringLen(title);
     return (uint8_t const*)title;
 }
@@ -1053,7 +1288,7 @@ void pincSdl2setWindowWidth(struct WindowBackend* obj, WindowHandle windowHandle
     // This function's documentation somehow manages to make the situation more confusing.
     // Really, I think we'll just have to abandon the idea of supporting scaling for the SDL2 backend
     // and work on implementing 'native' backends that deal with it properly.
-    this->libsdl2.setWindowSize(window->sdlWindow, (int)window->width, (int)window->height);
+    PincSdl2Lib(this).setWindowSize(window->sdlWindow, (int)window->width, (int)window->height);
     
 }
 
@@ -1062,17 +1297,17 @@ uint32_t pincSdl2getWindowWidth(struct WindowBackend* obj, WindowHandle window)
     PincSdl2Window* windowObj = (PincSdl2Window*)window;
     // SDL has a history of annoying issues around the size of a window in actual pixels
     int width = 0;
-    if(this->libsdl2.getWindowSizeInPixels) {
-        this->libsdl2.getWindowSizeInPixels(windowObj->sdlWindow, &width, NULL);
-    } else if(this->libsdl2.glGetDrawableSize) {
+    if(PincSdl2Lib(this).getWindowSizeInPixels) {
+        PincSdl2Lib(this).getWindowSizeInPixels(windowObj->sdlWindow, &width, NULL);
+    } else if(PincSdl2Lib(this).glGetDrawableSize) {
         // Only graphics api is OpenGl, shortcuts are made
-        this->libsdl2.glGetDrawableSize(windowObj->sdlWindow, &width, NULL);
+        PincSdl2Lib(this).glGetDrawableSize(windowObj->sdlWindow, &width, NULL);
     } else {
         // If the previously tried functions don't work, then it means this is a version of SDL from before it became hidpi aware.
         // There's not a lot we can do. If I'm not mistaken, non-dpi aware applications (in windows) are just fed incorrect window size values,
         // which can cause all kinds of issues.
         // Just assume the window size is equal to pixels. It's unlikely anyone is using an SDL2 version this old anyway.
-        this->libsdl2.getWindowSize(windowObj->sdlWindow, &width, NULL);
+        PincSdl2Lib(this).getWindowSize(windowObj->sdlWindow, &width, NULL);
     }
     PincAssertAssert(width <= INT32_MAX && width > 0, "Integer overflow", false, return 0;);
     PincAssertAssert((uint32_t)width == windowObj->width, "Window width and \"real\" width do not match!", false, return 0;);
@@ -1089,7 +1324,7 @@ void pincSdl2setWindowHeight(struct WindowBackend* obj, WindowHandle windowHandl
     // This function's documentation somehow manages to make the situation more confusing.
     // Really, I think we'll just have to abandon the idea of supporting scaling for the SDL2 backend
     // and work on implementing 'native' backends that deal with it properly.
-    this->libsdl2.setWindowSize(window->sdlWindow, (int)window->width, (int)window->height);
+    PincSdl2Lib(this).setWindowSize(window->sdlWindow, (int)window->width, (int)window->height);
 }
 
 uint32_t pincSdl2getWindowHeight(struct WindowBackend* obj, WindowHandle window) {
@@ -1097,17 +1332,17 @@ uint32_t pincSdl2getWindowHeight(struct WindowBackend* obj, WindowHandle window)
     PincSdl2Window* windowObj = (PincSdl2Window*)window;
     // SDL has a history of annoying issues around the size of a window in actual pixels
     int height = 0;
-    if(this->libsdl2.getWindowSizeInPixels) {
-        this->libsdl2.getWindowSizeInPixels(windowObj->sdlWindow, NULL, &height);
-    } else if(this->libsdl2.glGetDrawableSize) {
+    if(PincSdl2Lib(this).getWindowSizeInPixels) {
+        PincSdl2Lib(this).getWindowSizeInPixels(windowObj->sdlWindow, NULL, &height);
+    } else if(PincSdl2Lib(this).glGetDrawableSize) {
         // TODO(bluesillybeard): only graphics api is OpenGl, shortcuts are made
-        this->libsdl2.glGetDrawableSize(windowObj->sdlWindow, NULL, &height);
+        PincSdl2Lib(this).glGetDrawableSize(windowObj->sdlWindow, NULL, &height);
     } else {
         // If the previously tried functions don't work, then it means this is a version of SDL from before it became hidpi aware.
         // There's not a lot we can do. If I'm not mistaken, non-dpi aware applications (in windows) are just fed incorrect window size values,
         // which can cause all kinds of issues.
         // Just assume the window size is equal to pixels. It's unlikely anyone is using an SDL2 version this old anyway.
-        this->libsdl2.getWindowSize(windowObj->sdlWindow, NULL, &height);
+        PincSdl2Lib(this).getWindowSize(windowObj->sdlWindow, NULL, &height);
     }
     PincAssertAssert(height <= INT32_MAX && height > 0, "Integer overflow", false, return 0;);
     return (uint32_t)height;
@@ -1194,15 +1429,15 @@ PincErrorCode pincSdl2setVsync(struct WindowBackend* obj, bool vsync) {
     PincSdl2WindowBackend* this = (PincSdl2WindowBackend*)obj->obj;
     // TODO(bluesillybeard): only graphics backend is OpenGL, shortcuts are taken
     if(vsync) {
-        if(this->libsdl2.glSetSwapInterval(-1) == -1) {
+        if(PincSdl2Lib(this).glSetSwapInterval(-1) == -1) {
             // Try again with non-adaptive vsync
-            if(this->libsdl2.glSetSwapInterval(1) == -1) {
+            if(PincSdl2Lib(this).glSetSwapInterval(1) == -1) {
                 // big sad
                 return PincErrorCode_assert;
             }
         }
     } else {
-        if(this->libsdl2.glSetSwapInterval(0) == -1) {
+        if(PincSdl2Lib(this).glSetSwapInterval(0) == -1) {
             return PincErrorCode_assert;
         }
     }
@@ -1212,93 +1447,376 @@ PincErrorCode pincSdl2setVsync(struct WindowBackend* obj, bool vsync) {
 bool pincSdl2getVsync(struct WindowBackend* obj) {
     // TODO(bluesillybeard): only graphics backend is OpenGL, shortcuts are taken
     PincSdl2WindowBackend* this = (PincSdl2WindowBackend*)obj->obj;
-    return this->libsdl2.glGetSwapInterval() != 0;
+    return PincSdl2Lib(this).glGetSwapInterval() != 0;
 }
 
 void pincSdl2windowPresentFramebuffer(struct WindowBackend* obj, WindowHandle window) {
     PincSdl2Window* windowObj = (PincSdl2Window*)window;
     PincSdl2WindowBackend* this = (PincSdl2WindowBackend*)obj->obj;
     // TODO(bluesillybeard): only graphics backend is OpenGL, shortcuts are taken
-    this->libsdl2.glSwapWindow(windowObj->sdlWindow);
+    PincSdl2Lib(this).glSwapWindow(windowObj->sdlWindow);
 }
 
-PincOpenglSupportStatus pincSdl2queryGlVersionSupported(struct WindowBackend* obj, uint32_t major, uint32_t minor, PincOpenglContextProfile profile) {
+void* pincSdl2windowGetPixels(struct WindowBackend* obj, WindowHandle window, uint32_t* outStride) {
     P_UNUSED(obj);
-    P_UNUSED(major);
-    P_UNUSED(minor);
-    P_UNUSED(profile);
-    // SDL2 has no clean way to query OpenGL support before attempting to make a context.
-    return PincOpenglSupportStatus_maybe;
+    P_UNUSED(window);
+    *outStride = 0;
+    // TODO(bluesillybeard): SDL_GetWindowSurface could do this, once the SDL2 backend supports the raw graphics api
+    PincAssertUser(false, "The SDL2 backend does not support the raw graphics api", true, return 0;);
+    return 0;
 }
 
-PincOpenglSupportStatus pincSdl2queryGlAccumulatorBits(struct WindowBackend* obj, FramebufferFormat framebuffer, uint32_t channel, uint32_t bits) {
+bool pincSdl2windowReadPixels(struct WindowBackend* obj, WindowHandle window, void* dest, uint32_t destStride) {
     P_UNUSED(obj);
+    P_UNUSED(window);
+    P_UNUSED(dest);
+    P_UNUSED(destStride);
+    PincAssertUser(false, "The SDL2 backend does not support the raw graphics api", true, return false;);
+    return false;
+}
+
+// OpenGL probing.
+// SDL2 has no clean way to query OpenGL support before attempting to make a context, so Pinc attempts to make contexts on a hidden window.
+// Each thing is binary searched, assuming that if a value works then every lower value works too (context attributes are minimums).
+// Every trial starts from SDL's default attributes, so the results don't depend on each other (or on the framebuffer format).
+
+// Every OpenGL version there is, oldest first
+static uint8_t const pincSdl2GlVersions[][2] = {
+    {1, 0}, {1, 1}, {1, 2}, {1, 3}, {1, 4}, {1, 5}, {2, 0}, {2, 1},
+    {3, 0}, {3, 1}, {3, 2}, {3, 3}, {4, 0}, {4, 1}, {4, 2}, {4, 3}, {4, 4}, {4, 5}, {4, 6},
+};
+#define PINC_SDL2_GL_VERSIONS_NUM (sizeof(pincSdl2GlVersions) / sizeof(pincSdl2GlVersions[0]))
+
+#if PINC_OPENGL_PROBE
+static uint32_t const pincSdl2GlSampleCounts[] = {0, 2, 4, 8, 16, 32};
+#define PINC_SDL2_GL_SAMPLE_COUNTS_NUM (sizeof(pincSdl2GlSampleCounts) / sizeof(pincSdl2GlSampleCounts[0]))
+
+// Try to make a context with one thing changed from the defaults. Returns whether it worked.
+// This may run on the probe thread, so it must not touch anything other than SDL.
+static bool pincSdl2GlProbeTry(PincSdl2WindowBackend* this, PincSdl2GlProbeItem item, uint32_t value) {
+    #if PINC_OPENGL_PROBE == 2
+    // The lock only exists while the probe thread does, and the main thread only probes on its own once that's been waited for.
+    // The main thread keeps using SDL in the meantime, so each trial has to be done in one go while the main thread is out of it.
+    WindowBackendBackground* background = &this->glProbe.background;
+    bool locked = background->lock != 0;
+    if(locked) {
+        pincWindowBackendBackgroundLock(background);
+    }
+    #endif
+    // Creating a context makes it current, so whatever was current before has to be put back after
+    SDL_Window* oldWindow = PincSdl2Lib(this).glGetCurrentWindow();
+    SDL_GLContext oldContext = PincSdl2Lib(this).glGetCurrentContext();
+    PincSdl2Lib(this).glResetAttributes();
+    switch(item) {
+        case PincSdl2GlProbe_versionLegacy:
+        case PincSdl2GlProbe_versionCompatibility:
+        case PincSdl2GlProbe_versionCore:
+        case PincSdl2GlProbe_versionForward:
+            PincSdl2Lib(this).glSetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, pincSdl2GlVersions[value][0]);
+            PincSdl2Lib(this).glSetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, pincSdl2GlVersions[value][1]);
+            if(item == PincSdl2GlProbe_versionCompatibility) {
+                PincSdl2Lib(this).glSetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_COMPATIBILITY);
+            } else {
+                PincSdl2Lib(this).glSetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_CORE);
+            }
+            if(item == PincSdl2GlProbe_versionForward) {
+                PincSdl2Lib(this).glSetAttribute(SDL_GL_CONTEXT_FLAGS, SDL_GL_CONTEXT_FORWARD_COMPATIBLE_FLAG);
+            }
+            break;
+        case PincSdl2GlProbe_accumulatorBits:
+            PincSdl2Lib(this).glSetAttribute(SDL_GL_ACCUM_RED_SIZE, (int)value);
+            PincSdl2Lib(this).glSetAttribute(SDL_GL_ACCUM_GREEN_SIZE, (int)value);
+            PincSdl2Lib(this).glSetAttribute(SDL_GL_ACCUM_BLUE_SIZE, (int)value);
+            PincSdl2Lib(this).glSetAttribute(SDL_GL_ACCUM_ALPHA_SIZE, (int)value);
+            break;
+        case PincSdl2GlProbe_alphaBits:
+            PincSdl2Lib(this).glSetAttribute(SDL_GL_ALPHA_SIZE, (int)value);
+            break;
+        case PincSdl2GlProbe_depthBits:
+            PincSdl2Lib(this).glSetAttribute(SDL_GL_DEPTH_SIZE, (int)value);
+            break;
+        case PincSdl2GlProbe_stencilBits:
+            PincSdl2Lib(this).glSetAttribute(SDL_GL_STENCIL_SIZE, (int)value);
+            break;
+        case PincSdl2GlProbe_samples:
+            PincSdl2Lib(this).glSetAttribute(SDL_GL_MULTISAMPLEBUFFERS, value > 1 ? 1 : 0);
+            PincSdl2Lib(this).glSetAttribute(SDL_GL_MULTISAMPLESAMPLES, (int)value);
+            break;
+        case PincSdl2GlProbe_stereo:
+            PincSdl2Lib(this).glSetAttribute(SDL_GL_STEREO, 1);
+            break;
+        case PincSdl2GlProbe_debug:
+            PincSdl2Lib(this).glSetAttribute(SDL_GL_CONTEXT_FLAGS, SDL_GL_CONTEXT_DEBUG_FLAG);
+            break;
+        case PincSdl2GlProbe_robustAccess:
+            PincSdl2Lib(this).glSetAttribute(SDL_GL_CONTEXT_FLAGS, SDL_GL_CONTEXT_ROBUST_ACCESS_FLAG);
+            break;
+        case PincSdl2GlProbe_resetIsolation:
+            // Reset isolation is an addition to robust access
+            PincSdl2Lib(this).glSetAttribute(SDL_GL_CONTEXT_FLAGS, SDL_GL_CONTEXT_ROBUST_ACCESS_FLAG | SDL_GL_CONTEXT_RESET_ISOLATION_FLAG);
+            break;
+        default:
+            break;
+    }
+    SDL_GLContext context = PincSdl2Lib(this).glCreateContext(this->glProbe.window ? this->glProbe.window : this->dummyWindow->sdlWindow);
+    if(context) {
+        PincSdl2Lib(this).glDeleteContext(context);
+    }
+    PincSdl2Lib(this).glMakeCurrent(oldWindow, oldContext);
+    // Leave the attributes how the rest of the backend expects to find them
+    PincSdl2Lib(this).glResetAttributes();
+    #if PINC_OPENGL_PROBE == 2
+    if(locked) {
+        pincMutexUnlock(background->lock);
+    }
+    #endif
+    return context != 0;
+}
+
+// Find the highest index in [0, num) where the trial works, or -1 if none do.
+// valueOf maps an index to what gets tried, 0 to use the index directly.
+static int32_t pincSdl2GlProbeSearch(PincSdl2WindowBackend* this, PincSdl2GlProbeItem item, int32_t num, uint32_t const* valueOf) {
+    int32_t low = 0;
+    if(!pincSdl2GlProbeTry(this, item, valueOf ? valueOf[0] : 0)) {
+        return -1;
+    }
+    // low always works, everything past high never does
+    int32_t high = num - 1;
+    while(low < high) {
+        int32_t middle = low + (high - low + 1) / 2;
+        if(pincSdl2GlProbeTry(this, item, valueOf ? valueOf[middle] : (uint32_t)middle)) {
+            low = middle;
+        } else {
+            high = middle - 1;
+        }
+    }
+    return low;
+}
+
+// Probe one thing. Runs on the main thread or the probe thread.
+static void pincSdl2GlProbeItem(PincSdl2WindowBackend* this, PincSdl2GlProbeItem item) {
+    int32_t result = 0;
+    switch(item) {
+        case PincSdl2GlProbe_versionLegacy:
+            // SDL2 can't make legacy contexts, see pincSdl2glCompleteContext
+            result = 0;
+            break;
+        case PincSdl2GlProbe_versionCompatibility:
+        case PincSdl2GlProbe_versionCore:
+        case PincSdl2GlProbe_versionForward:
+            result = pincSdl2GlProbeSearch(this, item, (int32_t)PINC_SDL2_GL_VERSIONS_NUM, 0) + 1;
+            break;
+        case PincSdl2GlProbe_accumulatorBits:
+        case PincSdl2GlProbe_alphaBits:
+        case PincSdl2GlProbe_stencilBits:
+            // Nobody has more than 16 bits of these
+            result = pincSdl2GlProbeSearch(this, item, 17, 0);
+            break;
+        case PincSdl2GlProbe_depthBits:
+            result = pincSdl2GlProbeSearch(this, item, 33, 0);
+            break;
+        case PincSdl2GlProbe_samples: {
+            int32_t index = pincSdl2GlProbeSearch(this, item, (int32_t)PINC_SDL2_GL_SAMPLE_COUNTS_NUM, pincSdl2GlSampleCounts);
+            result = index < 0 ? -1 : (int32_t)pincSdl2GlSampleCounts[index];
+            break;
+        }
+        default:
+            result = pincSdl2GlProbeTry(this, item, 0) ? 1 : 0;
+            break;
+    }
+    this->glProbe.results[item] = result;
+    this->glProbe.probed |= (uint32_t)1 << item;
+}
+#endif
+
+#if PINC_OPENGL_PROBE == 2
+static void pincSdl2GlProbeThread(void* arg) {
+    PincSdl2WindowBackend* this = (PincSdl2WindowBackend*)arg;
+    for(uint32_t item=0; item<PincSdl2GlProbe_count; ++item) {
+        // Some of it may have come from the capability cache
+        if(!(this->glProbe.probed & ((uint32_t)1 << item))) {
+            pincSdl2GlProbeItem(this, (PincSdl2GlProbeItem)item);
+        }
+    }
+}
+
+static void pincSdl2GlProbeWait(struct WindowBackend* obj) {
+    PincSdl2WindowBackend* this = (PincSdl2WindowBackend*)obj->obj;
+    if(this->glProbe.thread) {
+        pincThreadJoin(this->glProbe.thread);
+        this->glProbe.thread = 0;
+    }
+    if(this->glProbe.background.lock) {
+        pincMutexDestroy(this->glProbe.background.lock);
+        this->glProbe.background.lock = 0;
+    }
+    if(this->glProbe.window) {
+        PincSdl2Lib(this).destroyWindow(this->glProbe.window);
+        this->glProbe.window = 0;
+    }
+}
+#endif
+
+void pincSdl2glProbeStart(struct WindowBackend* obj, GlProbeResults const* known) {
+    #if PINC_OPENGL_PROBE
+    PincSdl2WindowBackend* this = (PincSdl2WindowBackend*)obj->obj;
+    // A retained backend may have probed some of it already, which is at least as fresh as the cache
+    for(uint32_t item=0; item<PincSdl2GlProbe_count; ++item) {
+        uint32_t bit = (uint32_t)1 << item;
+        if((known->probed & bit) && !(this->glProbe.probed & bit)) {
+            this->glProbe.results[item] = known->results[item];
+            this->glProbe.probed |= bit;
+        }
+    }
+    #if PINC_OPENGL_PROBE == 2
+    if(this->glProbe.probed == ((uint32_t)1 << PincSdl2GlProbe_count) - 1) {
+        return;
+    }
+    // Windows can only be made on the main thread
+    this->glProbe.window = PincSdl2Lib(this).createWindow("Pinc OpenGL Probe", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, 1, 1, (uint32_t)SDL_WINDOW_OPENGL | (uint32_t)SDL_WINDOW_HIDDEN); //NOLINT: we do not have control over SDL macros
+    if(!this->glProbe.window) {
+        // Whatever didn't get probed will be probed on the dummy window when it's asked for instead
+        return;
+    }
+    this->glProbe.background = (WindowBackendBackground){
+        .running = true,
+        .lock = pincMutexCreate(),
+        .wait = pincSdl2GlProbeWait,
+    };
+    if(this->glProbe.background.lock) {
+        this->glProbe.thread = pincThreadCreate(pincSdl2GlProbeThread, this);
+    }
+    if(!this->glProbe.thread) {
+        pincSdl2GlProbeWait(obj);
+        this->glProbe.background.running = false;
+    }
+    #endif
+    #else
+    P_UNUSED(obj);
+    P_UNUSED(known);
+    #endif
+}
+
+// Make sure something has been probed, and get its result. Returns false if probing is off.
+static bool pincSdl2GlProbeGet(struct WindowBackend* obj, PincSdl2GlProbeItem item, int32_t* outResult) {
+    #if PINC_OPENGL_PROBE
+    PincSdl2WindowBackend* this = (PincSdl2WindowBackend*)obj->obj;
+    if(!(this->glProbe.probed & ((uint32_t)1 << item))) {
+        if(!pincSdl2GetDummyWindow(obj)) {
+            return false;
+        }
+        pincSdl2GlProbeItem(this, item);
+    }
+    *outResult = this->glProbe.results[item];
+    return true;
+    #else
+    P_UNUSED(obj);
+    P_UNUSED(item);
+    P_UNUSED(outResult);
+    return false;
+    #endif
+}
+
+// For the queries that ask whether some number of bits (or samples) work
+static PincOpenglSupportStatus pincSdl2GlProbeStatusAtMost(struct WindowBackend* obj, PincSdl2GlProbeItem item, uint32_t value) {
+    int32_t result = 0;
+    if(!pincSdl2GlProbeGet(obj, item, &result)) {
+        return PincOpenglSupportStatus_maybe;
+    }
+    return (result >= 0 && value <= (uint32_t)result) ? PincOpenglSupportStatus_definitely : PincOpenglSupportStatus_none;
+}
+
+// For the queries that ask whether a flag works
+static PincOpenglSupportStatus pincSdl2GlProbeStatusFlag(struct WindowBackend* obj, PincSdl2GlProbeItem item) {
+    int32_t result = 0;
+    if(!pincSdl2GlProbeGet(obj, item, &result)) {
+        return PincOpenglSupportStatus_maybe;
+    }
+    return result ? PincOpenglSupportStatus_definitely : PincOpenglSupportStatus_none;
+}
+
+PincOpenglSupportStatus pincSdl2queryGlVersionSupported(struct WindowBackend* obj, uint32_t major, uint32_t minor, PincOpenglContextProfile profile) {
+    if(profile > PincOpenglContextProfile_forward) {
+        return PincOpenglSupportStatus_none;
+    }
+    int32_t highest = 0;
+    if(!pincSdl2GlProbeGet(obj, (PincSdl2GlProbeItem)(PincSdl2GlProbe_versionLegacy + profile), &highest)) {
+        return PincOpenglSupportStatus_maybe;
+    }
+    if(highest == 0) {
+        return PincOpenglSupportStatus_none;
+    }
+    uint32_t highestMajor = pincSdl2GlVersions[highest-1][0];
+    uint32_t highestMinor = pincSdl2GlVersions[highest-1][1];
+    if(major < highestMajor || (major == highestMajor && minor <= highestMinor)) {
+        return PincOpenglSupportStatus_definitely;
+    }
+    return PincOpenglSupportStatus_none;
+}
+
+PincOpenglSupportStatus pincSdl2queryGlAccumulatorBits(struct WindowBackend* obj, FramebufferFormat framebuffer, uint32_t channel, uint32_t bits) {
     P_UNUSED(framebuffer);
+    // All of the channels are probed together
     P_UNUSED(channel);
-    P_UNUSED(bits);
-    // SDL2 has no clean way to query OpenGL support before attempting to make a context.
-    return PincOpenglSupportStatus_maybe;
+    return pincSdl2GlProbeStatusAtMost(obj, PincSdl2GlProbe_accumulatorBits, bits);
 }
 
 PincOpenglSupportStatus pincSdl2queryGlAlphaBits(struct WindowBackend* obj, FramebufferFormat framebuffer, uint32_t bits) {
-    P_UNUSED(obj);
     P_UNUSED(framebuffer);
-    P_UNUSED(bits);
-    // SDL2 has no clean way to query OpenGL support before attempting to make a context.
-    return PincOpenglSupportStatus_maybe;
+    return pincSdl2GlProbeStatusAtMost(obj, PincSdl2GlProbe_alphaBits, bits);
 }
 
 PincOpenglSupportStatus pincSdl2queryGlDepthBits(struct WindowBackend* obj, FramebufferFormat framebuffer, uint32_t bits) {
-    P_UNUSED(obj);
     P_UNUSED(framebuffer);
-    P_UNUSED(bits);
-    // SDL2 has no clean way to query OpenGL support before attempting to make a context.
-    return PincOpenglSupportStatus_maybe;
+    return pincSdl2GlProbeStatusAtMost(obj, PincSdl2GlProbe_depthBits, bits);
 }
 
 PincOpenglSupportStatus pincSdl2queryGlStencilBits(struct WindowBackend* obj, FramebufferFormat framebuffer, uint32_t bits) {
-    P_UNUSED(obj);
     P_UNUSED(framebuffer);
-    P_UNUSED(bits);
-    // SDL2 has no clean way to query OpenGL support before attempting to make a context.
-    return PincOpenglSupportStatus_maybe;
+    return pincSdl2GlProbeStatusAtMost(obj, PincSdl2GlProbe_stencilBits, bits);
 }
 
 PincOpenglSupportStatus pincSdl2queryGlSamples(struct WindowBackend* obj, FramebufferFormat framebuffer, uint32_t samples) {
-    P_UNUSED(obj);
     P_UNUSED(framebuffer);
-    P_UNUSED(samples);
-    // SDL2 has no clean way to query OpenGL support before attempting to make a context.
-    return PincOpenglSupportStatus_maybe;
+    // 1 sample is the same as no multisampling
+    return pincSdl2GlProbeStatusAtMost(obj, PincSdl2GlProbe_samples, samples > 1 ? samples : 0);
 }
 
 PincOpenglSupportStatus pincSdl2queryGlStereoBuffer(struct WindowBackend* obj, FramebufferFormat framebuffer) {
-    P_UNUSED(obj);
     P_UNUSED(framebuffer);
-    // SDL2 has no clean way to query OpenGL support before attempting to make a context.
-    return PincOpenglSupportStatus_maybe;
+    return pincSdl2GlProbeStatusFlag(obj, PincSdl2GlProbe_stereo);
 }
 
 PincOpenglSupportStatus pincSdl2queryGlContextDebug(struct WindowBackend* obj) {
-    P_UNUSED(obj);
-    // SDL2 has no clean way to query OpenGL support before attempting to make a context.
-    return PincOpenglSupportStatus_maybe;
+    return pincSdl2GlProbeStatusFlag(obj, PincSdl2GlProbe_debug);
 }
 
 PincOpenglSupportStatus pincSdl2queryGlRobustAccess(struct WindowBackend* obj) {
-    P_UNUSED(obj);
-    // SDL2 has no clean way to query OpenGL support before attempting to make a context.
-    return PincOpenglSupportStatus_maybe;
+    return pincSdl2GlProbeStatusFlag(obj, PincSdl2GlProbe_robustAccess);
 }
 
 PincOpenglSupportStatus pincSdl2queryGlResetIsolation(struct WindowBackend* obj) {
+    return pincSdl2GlProbeStatusFlag(obj, PincSdl2GlProbe_resetIsolation);
+}
+
+bool pincSdl2glProbeResults(struct WindowBackend* obj, GlProbeResults* outResults) {
+    #if PINC_OPENGL_PROBE
+    PincSdl2WindowBackend* this = (PincSdl2WindowBackend*)obj->obj;
+    *outResults = (GlProbeResults){.probed = this->glProbe.probed};
+    for(uint32_t item=0; item<PincSdl2GlProbe_count; ++item) {
+        outResults->results[item] = this->glProbe.results[item];
+    }
+    return true;
+    #else
     P_UNUSED(obj);
-    // SDL2 has no clean way to query OpenGL support before attempting to make a context.
-    return PincOpenglSupportStatus_maybe;
+    P_UNUSED(outResults);
+    return false;
+    #endif
 }
 
 RawOpenglContextHandle pincSdl2glCompleteContext(struct WindowBackend* obj, IncompleteGlContext incompleteContext) {
     PincSdl2WindowBackend* this = (PincSdl2WindowBackend*)obj->obj;
+    int64_t start = pincCurrentTimeNanos();
     FramebufferFormat* fmt = PincObject_ref_framebufferFormat(staticState.framebufferFormat);
     // Due to reasons, we have to create a compatible RGB framebuffer format for the context
     // TODO(bluesillybeard): is this actually valid?
@@ -1319,90 +1837,86 @@ RawOpenglContextHandle pincSdl2glCompleteContext(struct WindowBackend* obj, Inco
             PincAssertAssert(false, "Invalid number of channels in framebuffer format", false, return 0;);
     }
     channel_bits[3] = incompleteContext.alphaBits;
-    this->libsdl2.glSetAttribute(SDL_GL_RED_SIZE, (int)channel_bits[0]);
-    this->libsdl2.glSetAttribute(SDL_GL_GREEN_SIZE, (int)channel_bits[1]);
-    this->libsdl2.glSetAttribute(SDL_GL_BLUE_SIZE, (int)channel_bits[2]);
-    this->libsdl2.glSetAttribute(SDL_GL_ALPHA_SIZE, (int)channel_bits[3]);
-    this->libsdl2.glSetAttribute(SDL_GL_DEPTH_SIZE, (int)incompleteContext.depthBits);
-    this->libsdl2.glSetAttribute(SDL_GL_STENCIL_SIZE, (int)incompleteContext.stencilBits);
-    this->libsdl2.glSetAttribute(SDL_GL_ACCUM_RED_SIZE, (int)incompleteContext.accumulatorBits[0]);
-    this->libsdl2.glSetAttribute(SDL_GL_ACCUM_GREEN_SIZE, (int)incompleteContext.accumulatorBits[1]);
-    this->libsdl2.glSetAttribute(SDL_GL_ACCUM_BLUE_SIZE, (int)incompleteContext.accumulatorBits[2]);
-    this->libsdl2.glSetAttribute(SDL_GL_ACCUM_ALPHA_SIZE, (int)incompleteContext.accumulatorBits[3]);
+    PincSdl2Lib(this).glSetAttribute(SDL_GL_RED_SIZE, (int)channel_bits[0]);
+    PincSdl2Lib(this).glSetAttribute(SDL_GL_GREEN_SIZE, (int)channel_bits[1]);
+    PincSdl2Lib(this).glSetAttribute(SDL_GL_BLUE_SIZE, (int)channel_bits[2]);
+    PincSdl2Lib(this).glSetAttribute(SDL_GL_ALPHA_SIZE, (int)channel_bits[3]);
+    PincSdl2Lib(this).glSetAttribute(SDL_GL_DEPTH_SIZE, (int)incompleteContext.depthBits);
+    PincSdl2Lib(this).glSetAttribute(SDL_GL_STENCIL_SIZE, (int)incompleteContext.stencilBits);
+    PincSdl2Lib(this).glSetAttribute(SDL_GL_ACCUM_RED_SIZE, (int)incompleteContext.accumulatorBits[0]);
+    PincSdl2Lib(this).glSetAttribute(SDL_GL_ACCUM_GREEN_SIZE, (int)incompleteContext.accumulatorBits[1]);
+    PincSdl2Lib(this).glSetAttribute(SDL_GL_ACCUM_BLUE_SIZE, (int)incompleteContext.accumulatorBits[2]);
+    PincSdl2Lib(this).glSetAttribute(SDL_GL_ACCUM_ALPHA_SIZE, (int)incompleteContext.accumulatorBits[3]);
     int stereo = 0;
     if(incompleteContext.stereo) {
         stereo = 1;
     }
-    this->libsdl2.glSetAttribute(SDL_GL_STEREO, stereo);
+    PincSdl2Lib(this).glSetAttribute(SDL_GL_STEREO, stereo);
     // TODO(bluesillybeard): As far as I can tell, MULTISAMPLEBUFFERS is only 1 or 0. Nobody explains a use case with more than 1.
     // the ARB samples extension doesn't even mention the idea of more than one buffer, and has no way to set a number of them
     // But the ARB extension hasn't been modified in at least 15 years.
     if(incompleteContext.samples > 1) {
-        this->libsdl2.glSetAttribute(SDL_GL_MULTISAMPLEBUFFERS, 1);
+        PincSdl2Lib(this).glSetAttribute(SDL_GL_MULTISAMPLEBUFFERS, 1);
     } else {
-        this->libsdl2.glSetAttribute(SDL_GL_MULTISAMPLEBUFFERS, 0);
+        PincSdl2Lib(this).glSetAttribute(SDL_GL_MULTISAMPLEBUFFERS, 0);
     }
-    this->libsdl2.glSetAttribute(SDL_GL_MULTISAMPLESAMPLES, (int)incompleteContext.samples);
-    this->libsdl2.glSetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, (int)incompleteContext.versionMajor);
-    this->libsdl2.glSetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, (int)incompleteContext.versionMinor);
+    PincSdl2Lib(this).glSetAttribute(SDL_GL_MULTISAMPLESAMPLES, (int)incompleteContext.samples);
+    PincSdl2Lib(this).glSetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, (int)incompleteContext.versionMajor);
+    PincSdl2Lib(this).glSetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, (int)incompleteContext.versionMinor);
     int glFlags = 0;
     switch (incompleteContext.profile) {
         case PincOpenglContextProfile_legacy:
             PincAssertUser(false, "SDL2 does not support creating a legacy context", true, return 0;);
             return 0;
         case PincOpenglContextProfile_compatibility:
-            this->libsdl2.glSetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_COMPATIBILITY);
+            PincSdl2Lib(this).glSetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_COMPATIBILITY);
             break;
         case PincOpenglContextProfile_core:
-            this->libsdl2.glSetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_CORE);
+            PincSdl2Lib(this).glSetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_CORE);
             break;
         case PincOpenglContextProfile_forward:
-            this->libsdl2.glSetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_CORE);
+            PincSdl2Lib(this).glSetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_CORE);
             glFlags |= SDL_GL_CONTEXT_FORWARD_COMPATIBLE_FLAG; //NOLINT: SDL wants an int
             break;
         default:
             PincAssertUser(false, "Invalid opengl context profile", true, return 0;)
     }
     if(incompleteContext.robustAccess) {
-        glFlags |= SDL_GL_CONTEXT_FORWARD_COMPATIBLE_FLAG; //NOLINT: SDL wants an int
+        glFlags |= SDL_GL_CONTEXT_ROBUST_ACCESS_FLAG; //NOLINT: SDL wants an int
+    }
+    if(incompleteContext.resetIsolation) {
+        glFlags |= SDL_GL_CONTEXT_RESET_ISOLATION_FLAG; //NOLINT: SDL wants an int
     }
     if(incompleteContext.debug) {
         glFlags |= SDL_GL_CONTEXT_DEBUG_FLAG; //NOLINT: SDL wants an int
     }
-    this->libsdl2.glSetAttribute(SDL_GL_CONTEXT_FLAGS, glFlags);
+    PincSdl2Lib(this).glSetAttribute(SDL_GL_CONTEXT_FLAGS, glFlags);
     int share = 0;
     if(incompleteContext.shareWithCurrent) {
         share = 1;
     }
-    this->libsdl2.glSetAttribute(SDL_GL_SHARE_WITH_CURRENT_CONTEXT, share);
+    PincSdl2Lib(this).glSetAttribute(SDL_GL_SHARE_WITH_CURRENT_CONTEXT, share);
 
     // TODO(bluesillybeard): SDL says it needs the attributes set before creating the window,
     // But is that actually true beyond just the framebuffer format?
     PincSdl2Window* dummyWindow = pincSdl2GetDummyWindow(obj);
-    SDL_GLContext sdlGlContext = this->libsdl2.glCreateContext(dummyWindow->sdlWindow);
+    SDL_GLContext sdlGlContext = PincSdl2Lib(this).glCreateContext(dummyWindow->sdlWindow);
     if(!sdlGlContext) {
-        #if PINC_ENABLE_ERROR_EXTERNAL
-        PincString errorMsg = pincString_concat(2, (PincString[]){
-            pincString_makeDirect((char*)"SDL2 backend: Could not create OpenGl context: "),
-            // const is not an issue, this string will not be modified
-            pincString_makeDirect((char*)this->libsdl2.getError()),
-        },tempAllocator);
-        PincAssertExternalStr(false, errorMsg, true, return 0;);// Probably recoverable? Look into it.
-        pincString_free(&errorMsg, tempAllocator);
-        #endif
+        PincAssertExternalDetail(false, "SDL2 backend: Could not create OpenGl context: ", PincSdl2Lib(this).getError(), true, return 0;);// Probably recoverable? Look into it.
         return 0;
     }
     // This is to stop users from assuming the context will be current after completion, like what SDL2 does.
-    this->libsdl2.glMakeCurrent(0, 0);
+    PincSdl2Lib(this).glMakeCurrent(0, 0);
     // Unlike a window, an OpenGl context contains no other information than just the opaque pointer
     // So no need to wrap it in a struct or anything
+    pincStartupPhaseRecord(PincStartupPhase_openglContextComplete, start);
     return sdlGlContext;
 }
 
 void pincSdl2glDeinitContext(struct WindowBackend* obj, RawOpenglContextObject context) {
     PincSdl2WindowBackend* this = (PincSdl2WindowBackend*)obj->obj;
     SDL_GLContext sdlGlContext = (SDL_GLContext)context.handle;
-    this->libsdl2.glDeleteContext(sdlGlContext);
+    PincSdl2Lib(this).glDeleteContext(sdlGlContext);
 }
 
 uint32_t pincSdl2glGetContextAccumulatorBits(struct WindowBackend* obj, RawOpenglContextObject context, uint32_t channel){
@@ -1483,16 +1997,9 @@ PincErrorCode pincSdl2glMakeCurrent(struct WindowBackend* obj, WindowHandle wind
     // So no need to wrap it in a struct or anything
     // NOTE: context may be null to indicate no context should be current
     SDL_GLContext contextObj = (SDL_GLContext)context;
-    int result = this->libsdl2.glMakeCurrent(windowObj->sdlWindow, contextObj);
+    int result = PincSdl2Lib(this).glMakeCurrent(windowObj->sdlWindow, contextObj);
     if(result != 0) {
-        #if PINC_ENABLE_ERROR_EXTERNAL
-        PincString errorMsg = pincString_concat(2, (PincString[]){
-            pincString_makeDirect((char*)"SDL2 backend: Could not make context current: "),
-            pincString_makeDirect((char*)this->libsdl2.getError()),
-        },tempAllocator);
-        PincAssertExternalStr(false, errorMsg, true, return PincErrorCode_assert;);
-        pincString_free(&errorMsg, tempAllocator);
-        #endif
+        PincAssertExternalDetail(false, "SDL2 backend: Could not make context current: ", PincSdl2Lib(this).getError(), true, return PincErrorCode_assert;);
         return PincErrorCode_assert;
     }
     return PincErrorCode_pass;
@@ -1500,12 +2007,13 @@ PincErrorCode pincSdl2glMakeCurrent(struct WindowBackend* obj, WindowHandle wind
 
 PincWindowHandle pincSdl2glGetCurrentWindow(struct WindowBackend* obj) {
     PincSdl2WindowBackend* this = (PincSdl2WindowBackend*)obj->obj;
-    SDL_Window* sdlWin = this->libsdl2.glGetCurrentWindow();
+    SDL_Window* sdlWin = PincSdl2Lib(this).glGetCurrentWindow();
     if(!sdlWin) {
         return 0;
     }
-    PincSdl2Window* thisWin = this->libsdl2.getWindowData(sdlWin, "pincSdl2Window");
-    if(!thisWin) {
+    PincSdl2Window* thisWin = PincSdl2Lib(this).getWindowData(sdlWin, "pincSdl2Window");
+    // Could be another instance's window
+    if(!thisWin || thisWin->backend != this) {
         return 0;
     }
     return thisWin->frontHandle;
@@ -1514,7 +2022,7 @@ PincWindowHandle pincSdl2glGetCurrentWindow(struct WindowBackend* obj) {
 PincOpenglContextHandle pincSdl2glGetCurrentContext(struct WindowBackend* obj) {
     // TODO(bluesillybeard): I'm not too confident about this function, it should be tested properly
     PincSdl2WindowBackend* this = (PincSdl2WindowBackend*)obj->obj;
-    SDL_GLContext sdlContext = this->libsdl2.glGetCurrentContext();
+    SDL_GLContext sdlContext = PincSdl2Lib(this).glGetCurrentContext();
     if(!sdlContext) {
         return 0;
     }
@@ -1535,8 +2043,8 @@ PincOpenglContextHandle pincSdl2glGetCurrentContext(struct WindowBackend* obj) {
 
 PincPfn pincSdl2glGetProc(struct WindowBackend* obj, char const* procname) {
     PincSdl2WindowBackend* this = (PincSdl2WindowBackend*)obj->obj;
-    PincAssertUser(this->libsdl2.glGetCurrentContext(), "Cannot get proc address of an OpenGL function without a current context", true, return 0;);
-    return this->libsdl2.glGetProcAddress(procname);
+    PincAssertUser(PincSdl2Lib(this).glGetCurrentContext(), "Cannot get proc address of an OpenGL function without a current context", true, return 0;);
+    return PincSdl2Lib(this).glGetProcAddress(procname);
 }
 
 #endif
@@ -1,4 +1,14 @@
 #include "pinc_window.h"
 #include <stdbool.h>
 
+// Loading is split in two, so the slow part that doesn't need the main thread can happen on another one (see pincInitIncompleteAsync).
+// pincSdl2Load loads the library and is fine on any thread, pincSdl2Init does the rest and needs the main thread.
+bool pincSdl2Load(WindowBackend* obj);
 bool pincSdl2Init(WindowBackend* obj);
+
+// Instead of deinit, for pincSetRetainBackend. Returns the backend object, which pincSdl2Load picks back up from staticState.retained.
+void* pincSdl2Retain(WindowBackend* obj);
+
+// For the frontend to call directly, on a backend whose vtable isn't filled in (a retained one, or one that was only loaded)
+void pincSdl2deinit(struct WindowBackend* obj);
+void pincSdl2deinitFast(struct WindowBackend* obj);
@@ -19,10 +19,12 @@
 #define SDL_FUNCTIONS \
     SDL_FUNC(int, init, SDL_Init, (uint32_t flags)) \
     SDL_FUNC(void, quit, SDL_Quit, (void)) \
+    SDL_FUNC(void, quitSubSystem, SDL_QuitSubSystem, (uint32_t flags)) \
     SDL_FUNC(void, getVersion, SDL_GetVersion, (SDL_version* ver)) \
     SDL_FUNC(int, getNumVideoDisplays, SDL_GetNumVideoDisplays, (void)) \
     SDL_FUNC(int, getNumDisplayModes, SDL_GetNumDisplayModes, (int displayIndex)) \
     SDL_FUNC(int, getDisplayMode, SDL_GetDisplayMode, (int displayIndex, int modeIndex, SDL_DisplayMode* outMode)) \
+    SDL_FUNC(int, getDesktopDisplayMode, SDL_GetDesktopDisplayMode, (int displayIndex, SDL_DisplayMode* outMode)) \
     SDL_FUNC(SDL_PixelFormat*, allocFormat, SDL_AllocFormat, (uint32_t pixelFormat)) \
     SDL_FUNC(void, freeFormat, SDL_FreeFormat, (SDL_PixelFormat* format)) \
     SDL_FUNC(SDL_Window*, createWindow, SDL_CreateWindow, (char const* title, int x, int y, int width, int height, uint32_t flags)) \
@@ -31,6 +33,8 @@
     SDL_FUNC(char const*, getError, SDL_GetError, (void)) \
     SDL_FUNC(void, setWindowTitle, SDL_SetWindowTitle, (SDL_Window* window, char const* title)) \
     SDL_FUNC(int, pollEvent, SDL_PollEvent, (SDL_Event* event)) \
+    SDL_FUNC(void, flushEvents, SDL_FlushEvents, (uint32_t minType, uint32_t maxType)) \
+    SDL_FUNC(int, pushEvent, SDL_PushEvent, (SDL_Event* event)) \
     SDL_FUNC(void*, setWindowData, SDL_SetWindowData, (SDL_Window* window, char const* name, void* userdata)) \
     SDL_FUNC(void*, getWindowData, SDL_GetWindowData, (SDL_Window* window, char const* name)) \
     SDL_FUNC(SDL_Window*, getWindowFromId, SDL_GetWindowFromID, (uint32_t window_id)) \
@@ -42,6 +46,7 @@
     SDL_FUNC(SDL_GLContext, glGetCurrentContext, SDL_GL_GetCurrentContext, (void)) \
     SDL_FUNC(SDL_Window*, glGetCurrentWindow, SDL_GL_GetCurrentWindow, (void)) \
     SDL_FUNC(int, glSetAttribute, SDL_GL_SetAttribute, (SDL_GLattr attr, int value)) \
+    SDL_FUNC(void, glResetAttributes, SDL_GL_ResetAttributes, (void)) \
     SDL_FUNC(void, getWindowSize, SDL_GetWindowSize, (SDL_Window* window, int* width, int* height)) \
     /* added in 2.0.1 */ SDL_FUNC_OPTIONAL(void, glGetDrawableSize, SDL_GL_GetDrawableSize, (SDL_Window* window, int* width, int* height)) \
     /* added in 2.26.0 */ SDL_FUNC_OPTIONAL(void, getWindowSizeInPixels, SDL_GetWindowSizeInPixels, (SDL_Window* window, int* width, int* height)) \
@@ -80,16 +85,69 @@ typedef struct {
 #undef SDL_FUNC
 #undef SDL_FUNC_OPTIONAL
 
+#if PINC_SDL2_LINK_DIRECT
+
+// SDL2 is linked with the program, so the table is filled in by the linker instead of by dlsym.
+// The table is a compile time constant, so the compiler turns every call through it into a direct call.
+// The optional functions are only optional at runtime, so this needs SDL 2.26 or newer to link.
+
+#define SDL_FUNC(type, name, realName, args) .name = (PFN_##realName) realName,
+#define SDL_FUNC_OPTIONAL(type, name, realName, args) .name = (PFN_##realName) realName,
+
+static Sdl2Functions const pincSdl2DirectFunctions = {
+    SDL_FUNCTIONS
+};
+
+#undef SDL_FUNC
+#undef SDL_FUNC_OPTIONAL
+
+// _this is only evaluated so the backend pointer counts as used in both modes
+#define PincSdl2Lib(_this) ((void)(_this), pincSdl2DirectFunctions)
+
+#else
+
+#define PincSdl2Lib(_this) ((_this)->libsdl2)
+
+// Every name and length is put into a table at compile time, so the whole set can be resolved with a single pincLibrarySymbols call
+// instead of measuring and copying each name one at a time.
+
+#define SDL_FUNC(type, name, realName, args) (uint8_t const*)#realName,
+#define SDL_FUNC_OPTIONAL(type, name, realName, args) (uint8_t const*)#realName,
+
+static uint8_t const* const pincSdl2FunctionNames[] = {
+    SDL_FUNCTIONS
+};
+
+#undef SDL_FUNC
+#undef SDL_FUNC_OPTIONAL
+
+#define SDL_FUNC(type, name, realName, args) sizeof(#realName)-1,
+#define SDL_FUNC_OPTIONAL(type, name, realName, args) sizeof(#realName)-1,
+
+static size_t const pincSdl2FunctionNameSizes[] = {
+    SDL_FUNCTIONS
+};
+
+#undef SDL_FUNC
+#undef SDL_FUNC_OPTIONAL
+
+#define PINC_SDL2_NUM_FUNCTIONS (sizeof(pincSdl2FunctionNames) / sizeof(pincSdl2FunctionNames[0]))
+
 #define SDL_FUNC(type, name, realName, args)\
-    functions->name = (PFN_##realName) pincLibrarySymbol(lib, (uint8_t*)#realName, pincStringLen(#realName));\
+    functions->name = (PFN_##realName) symbols[symbolIndex++];\
     PincAssertExternal(functions->name, "Unable to load SDL2 function " #realName, false, return;);
 
 #define SDL_FUNC_OPTIONAL(type, name, realName, args)\
-    functions->name = (PFN_##realName) pincLibrarySymbol(lib, (uint8_t*)#realName, pincStringLen(#realName));\
+    functions->name = (PFN_##realName) symbols[symbolIndex++];\
 
 void pincLoadSdl2Functions(void* lib, Sdl2Functions* functions) { //NOLINT: this function is auto-generated by the macros. One could argue that is just as bad, but here we are.
+    pincPFN symbols[PINC_SDL2_NUM_FUNCTIONS];
+    pincLibrarySymbols(lib, pincSdl2FunctionNames, pincSdl2FunctionNameSizes, symbols, PINC_SDL2_NUM_FUNCTIONS);
+    size_t symbolIndex = 0;
     SDL_FUNCTIONS
 }
 
 #undef SDL_FUNC
 #undef SDL_FUNC_OPTIONAL
+
+#endif
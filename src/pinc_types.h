@@ -51,6 +51,17 @@ typedef struct {
 
 typedef void* RawOpenglContextHandle;
 
+// How many results a backend's OpenGL probe can have, see GlProbeResults
+#define PINC_GL_PROBE_RESULTS_CAPACITY 16
+
+// What a window backend found out about OpenGL support by trying it (see PINC_OPENGL_PROBE), so it can go in the capability cache.
+// What each result means is up to the backend.
+typedef struct {
+    // Bit for each result that is known
+    uint32_t probed;
+    int32_t results[PINC_GL_PROBE_RESULTS_CAPACITY];
+} GlProbeResults;
+
 typedef struct {
     RawOpenglContextHandle handle;
     PincOpenglContextHandle front_handle;
@@ -8,6 +8,10 @@
 
 #include "pinc_types.h"
 #include "pinc_error.h"
+#include "platform/pinc_platform.h"
+
+// Whether a backend may be doing work on another thread after its init, which everything else has to wait for
+#define PINC_WINDOW_BACKEND_BACKGROUND_WORK (PINC_OPENGL_PROBE == 2)
 
 // Tip: if you don't know what's going on with macros, use the '-E' flag in gcc to preprocess the file without compiling it.
 
@@ -17,7 +21,8 @@ struct WindowBackend;
 #define PINC_WINDOW_INTERFACE_FUNCTION(type, arguments, name, argumentsNames, defaultReturn)
 #define PINC_WINDOW_INTERFACE_PROCEDURE(arguments, name, argumentsNames)
 
-#define PINC_WINDOW_INTERFACE \
+// Everything except the OpenGL functions, see PINC_WINDOW_INTERFACE_OPENGL
+#define PINC_WINDOW_INTERFACE_GENERAL \
     /* These functions are not part of the interface, and instead are handled differently for each backend. */ \
     /* PINC_WINDOW_INTERFACE_PROCEDURE((WindowBackend* obj), initIncomplete)*/ \
     /* PINC_WINDOW_INTERFACE_FUNCTION(bool, (WindowBackend* obj), isSupported) */ \
@@ -25,9 +30,18 @@ struct WindowBackend;
     PINC_WINDOW_INTERFACE_FUNCTION(FramebufferFormat*, (struct WindowBackend* obj, PincAllocator allocator, size_t* outNumFormats), queryFramebufferFormats, (obj, allocator, outNumFormats), 0) \
     PINC_WINDOW_INTERFACE_FUNCTION(bool, (struct WindowBackend* obj, PincGraphicsApi api), queryGraphicsApiSupport, (obj, api), false) \
     PINC_WINDOW_INTERFACE_FUNCTION(uint32_t, (struct WindowBackend* obj), queryMaxOpenWindows, (obj), 0) \
+    /* A hash of everything that could change what the query functions return (library version, displays, etc). */ \
+    /* The capability cache is thrown out when this changes. 0 if the backend can't tell, which disables the cache. */ \
+    PINC_WINDOW_INTERFACE_FUNCTION(uint64_t, (struct WindowBackend* obj), queryConfigurationHash, (obj), 0) \
+    /* Called once after the backend's init. Take what the capability cache knows about OpenGL (nothing if it's all unprobed), */ \
+    /* and start probing the rest in the background if the backend does that. */ \
+    PINC_WINDOW_INTERFACE_PROCEDURE((struct WindowBackend* obj, GlProbeResults const* known), glProbeStart, (obj, known)) \
     /* The window backend is in charge of initializing the graphics api at this point */ \
     PINC_WINDOW_INTERFACE_FUNCTION(PincErrorCode, (struct WindowBackend* obj, PincGraphicsApi graphicsApi, FramebufferFormat framebuffer), completeInit, (obj, graphicsApi, framebuffer), PincErrorCode_assert) \
     PINC_WINDOW_INTERFACE_PROCEDURE((struct WindowBackend* obj), deinit, (obj)) \
+    /* For pincDeinitFast: only get rid of what the OS would not clean up by itself right away (windows, the display connection). Don't free anything. */ \
+    /* OpenGL contexts and windows may still exist when this is called. */ \
+    PINC_WINDOW_INTERFACE_PROCEDURE((struct WindowBackend* obj), deinitFast, (obj)) \
     PINC_WINDOW_INTERFACE_PROCEDURE((struct WindowBackend* obj), step, (obj)) \
     /* ### Window Property Functions ## */ \
     /* May return null in the case of an error */ \
@@ -57,6 +71,14 @@ struct WindowBackend;
     PINC_WINDOW_INTERFACE_FUNCTION(bool, (struct WindowBackend* obj), getVsync, (obj), false) \
     /* ### Other Window Functions ### */ \
     PINC_WINDOW_INTERFACE_PROCEDURE((struct WindowBackend* obj, WindowHandle window), windowPresentFramebuffer, (obj, window)) \
+    /* ### Raw graphics api functions ### */ \
+    /* The back buffer to draw into, one row every outStride bytes. Valid until the window is presented or resized. */ \
+    PINC_WINDOW_INTERFACE_FUNCTION(void*, (struct WindowBackend* obj, WindowHandle window, uint32_t* outStride), windowGetPixels, (obj, window, outStride), 0) \
+    /* Copy the last presented frame into dest, one row every destStride bytes */ \
+    PINC_WINDOW_INTERFACE_FUNCTION(bool, (struct WindowBackend* obj, WindowHandle window, void* dest, uint32_t destStride), windowReadPixels, (obj, window, dest, destStride), false) \
+
+// Kept separate from the rest, since these are the functions that need a backend's background work (OpenGL probing) to be finished first.
+#define PINC_WINDOW_INTERFACE_OPENGL \
     /* ### OpenGL functions */ \
     PINC_WINDOW_INTERFACE_FUNCTION(PincOpenglSupportStatus, (struct WindowBackend* obj, uint32_t major, uint32_t minor, PincOpenglContextProfile profile) , queryGlVersionSupported, (obj, major, minor, profile), PincOpenglSupportStatus_maybe) \
     PINC_WINDOW_INTERFACE_FUNCTION(PincOpenglSupportStatus, (struct WindowBackend* obj, FramebufferFormat framebuffer, uint32_t channel, uint32_t bits), queryGlAccumulatorBits, (obj, framebuffer, channel, bits), PincOpenglSupportStatus_maybe) \
@@ -68,6 +90,8 @@ struct WindowBackend;
     PINC_WINDOW_INTERFACE_FUNCTION(PincOpenglSupportStatus, (struct WindowBackend* obj), queryGlContextDebug, (obj), PincOpenglSupportStatus_maybe) \
     PINC_WINDOW_INTERFACE_FUNCTION(PincOpenglSupportStatus, (struct WindowBackend* obj), queryGlRobustAccess, (obj), PincOpenglSupportStatus_maybe) \
     PINC_WINDOW_INTERFACE_FUNCTION(PincOpenglSupportStatus, (struct WindowBackend* obj), queryGlResetIsolation, (obj), PincOpenglSupportStatus_maybe) \
+    /* Everything probed so far, for the capability cache. False if the backend doesn't probe. */ \
+    PINC_WINDOW_INTERFACE_FUNCTION(bool, (struct WindowBackend* obj, GlProbeResults* outResults), glProbeResults, (obj, outResults), false) \
     PINC_WINDOW_INTERFACE_FUNCTION(RawOpenglContextHandle, (struct WindowBackend* obj, IncompleteGlContext incompleteContext), glCompleteContext, (obj, incompleteContext), 0) \
     PINC_WINDOW_INTERFACE_PROCEDURE((struct WindowBackend* obj, RawOpenglContextObject context), glDeinitContext, (obj, context)) \
     PINC_WINDOW_INTERFACE_FUNCTION(uint32_t, (struct WindowBackend* obj, RawOpenglContextObject context, uint32_t channel), glGetContextAccumulatorBits, (obj, context, channel), 0) \
@@ -84,6 +108,8 @@ struct WindowBackend;
     PINC_WINDOW_INTERFACE_FUNCTION(PincOpenglContextHandle, (struct WindowBackend* obj), glGetCurrentContext, (obj), 0) \
     PINC_WINDOW_INTERFACE_FUNCTION(PincPfn, (struct WindowBackend* obj, char const* procname), glGetProc, (obj, procname), 0) \
 
+#define PINC_WINDOW_INTERFACE PINC_WINDOW_INTERFACE_GENERAL PINC_WINDOW_INTERFACE_OPENGL
+
 #undef PINC_WINDOW_INTERFACE_FUNCTION
 #undef PINC_WINDOW_INTERFACE_PROCEDURE
 
@@ -96,16 +122,148 @@ struct WindowBackendVtable {
     PINC_WINDOW_INTERFACE
 };
 
+#if PINC_WINDOW_BACKEND_BACKGROUND_WORK
+// Work a backend does on another thread after its init, like OpenGL probing. Only the OpenGL functions have to wait for it to finish.
+// Everything else runs alongside it, one at a time: the work holds the lock while it uses the backend's library, and the main thread holds it for each call into the backend.
+// This lives in the backend's own object, so every copy of the WindowBackend sees the same one.
+typedef struct {
+    // Main thread only. Set while the work may still be running, and cleared once it's been waited for.
+    bool running;
+    void* lock;
+    // Nonzero while the main thread is waiting for the lock. The work backs off in between its steps until it gets it,
+    // since the main thread is what the user is waiting for.
+    PincAtomicInt32 mainWaiting;
+    // Wait for the work to finish, and destroy the lock
+    void (*wait)(struct WindowBackend* obj);
+} WindowBackendBackground;
+#endif
+
 typedef struct WindowBackend {
     void* obj;
+    // Which backend this is, set by the backend when it loads. Direct calls (see PINC_WINDOW_BACKEND_DIRECT) branch on it.
+    PincWindowBackend id;
     // These are inlined instead of using a vtable, because there will only one of these.
     // It reduces the indirection a bit, at the cost of making this struct massive.
     struct WindowBackendVtable vt;
+    #if PINC_WINDOW_BACKEND_BACKGROUND_WORK
+    // Nullable, set by the backend if it has background work
+    WindowBackendBackground* background;
+    #endif
 } WindowBackend;
 
 #undef PINC_WINDOW_INTERFACE_FUNCTION
 #undef PINC_WINDOW_INTERFACE_PROCEDURE
 
+// Wait for any work the backend is doing on another thread. Must not be called while holding the lock from pincWindowBackendLock.
+static P_INLINE void pincWindowBackendSync(struct WindowBackend* obj) {
+    #if PINC_WINDOW_BACKEND_BACKGROUND_WORK
+    WindowBackendBackground* background = obj->background;
+    if(background && background->running) {
+        background->running = false;
+        background->wait(obj);
+    }
+    #else
+    P_UNUSED(obj);
+    #endif
+}
+
+// Keep the backend's background work out of the backend's library for one call. Returns whether there was anything to lock.
+static P_INLINE bool pincWindowBackendLock(struct WindowBackend* obj) {
+    #if PINC_WINDOW_BACKEND_BACKGROUND_WORK
+    WindowBackendBackground* background = obj->background;
+    if(background && background->running) {
+        pincAtomicFetchAddInt32(&background->mainWaiting, 1);
+        pincMutexLock(background->lock);
+        pincAtomicFetchAddInt32(&background->mainWaiting, -1);
+        return true;
+    }
+    #endif
+    P_UNUSED(obj);
+    return false;
+}
+
+static P_INLINE void pincWindowBackendUnlock(struct WindowBackend* obj, bool locked) {
+    #if PINC_WINDOW_BACKEND_BACKGROUND_WORK
+    if(locked) {
+        pincMutexUnlock(obj->background->lock);
+    }
+    #else
+    P_UNUSED(obj);
+    P_UNUSED(locked);
+    #endif
+}
+
+#if PINC_WINDOW_BACKEND_BACKGROUND_WORK
+// For the background work itself: take the lock for one step of the work, letting the main thread go first if it's waiting
+static P_INLINE void pincWindowBackendBackgroundLock(WindowBackendBackground* background) {
+    while(pincAtomicLoadInt32(&background->mainWaiting) > 0) {
+        pincSleepNanos(50000);
+    }
+    pincMutexLock(background->lock);
+}
+#endif
+
+// How many window backends are compiled in
+#define PINC_WINDOW_BACKEND_NUM (PINC_HAVE_WINDOW_SDL2 + PINC_HAVE_WINDOW_NONE)
+
+#if PINC_DIRECT_WINDOW_BACKEND && PINC_WINDOW_BACKEND_NUM >= 1
+// Every backend that is compiled in is known at compile time. The wrappers call them directly instead of going through the vtable,
+// which lets the compiler inline the backend into the frontend (especially in the unity build).
+// With more than one backend, that's a branch on the backend's id instead of an indirect call.
+# define PINC_WINDOW_BACKEND_DIRECT 1
+#else
+# define PINC_WINDOW_BACKEND_DIRECT 0
+#endif
+
+#if PINC_WINDOW_BACKEND_DIRECT
+
+#if PINC_HAVE_WINDOW_SDL2 && PINC_HAVE_WINDOW_NONE
+// Both operands have the interface function's type, including void for procedures
+# define PINC_WINDOW_BACKEND_DIRECT_CALL(obj, name, argumentsNames) ((obj)->id == PincWindowBackend_none ? pincNone##name argumentsNames : pincSdl2##name argumentsNames)
+#elif PINC_HAVE_WINDOW_SDL2
+# define PINC_WINDOW_BACKEND_DIRECT_CALL(obj, name, argumentsNames) pincSdl2##name argumentsNames
+#elif PINC_HAVE_WINDOW_NONE
+# define PINC_WINDOW_BACKEND_DIRECT_CALL(obj, name, argumentsNames) pincNone##name argumentsNames
+#endif
+
+#if PINC_HAVE_WINDOW_SDL2
+#define PINC_WINDOW_INTERFACE_FUNCTION(type, arguments, name, argumentsNames, defaultReturn) type pincSdl2##name arguments;
+#define PINC_WINDOW_INTERFACE_PROCEDURE(arguments, name, argumentsNames) void pincSdl2##name arguments;
+
+PINC_WINDOW_INTERFACE
+
+#undef PINC_WINDOW_INTERFACE_FUNCTION
+#undef PINC_WINDOW_INTERFACE_PROCEDURE
+#endif
+
+#if PINC_HAVE_WINDOW_NONE
+#define PINC_WINDOW_INTERFACE_FUNCTION(type, arguments, name, argumentsNames, defaultReturn) type pincNone##name arguments;
+#define PINC_WINDOW_INTERFACE_PROCEDURE(arguments, name, argumentsNames) void pincNone##name arguments;
+
+PINC_WINDOW_INTERFACE
+
+#undef PINC_WINDOW_INTERFACE_FUNCTION
+#undef PINC_WINDOW_INTERFACE_PROCEDURE
+#endif
+
+// Each backend implements every function in the interface (otherwise it would not link), so there is nothing to check.
+#define PINC_WINDOW_INTERFACE_FUNCTION(type, arguments, name, argumentsNames, defaultReturn)\
+    static P_INLINE type pincWindowBackend_##name arguments { \
+        PINC_WINDOW_BACKEND_ENTER(obj) \
+        type result = PINC_WINDOW_BACKEND_DIRECT_CALL(obj, name, argumentsNames);\
+        PINC_WINDOW_BACKEND_LEAVE(obj) \
+        return result; \
+    }
+
+#define PINC_WINDOW_INTERFACE_PROCEDURE(arguments, name, argumentsNames)\
+    static P_INLINE void pincWindowBackend_##name arguments { \
+        PINC_WINDOW_BACKEND_ENTER(obj) \
+        PINC_WINDOW_BACKEND_DIRECT_CALL(obj, name, argumentsNames);\
+        PINC_WINDOW_BACKEND_LEAVE(obj) \
+    }
+
+#else
+
 // nice wrapper functions for the WindowBackend functions
 
 #define PINC_WINDOW_INTERFACE_FUNCTION(type, arguments, name, argumentsNames, defaultReturn)\
@@ -114,7 +272,10 @@ typedef struct WindowBackend {
             PincAssertExternal(false, "Function " #name " Is not implemented for this window backend!", true, ;); \
             return (defaultReturn); \
         } \
-        return obj -> vt.name argumentsNames;\
+        PINC_WINDOW_BACKEND_ENTER(obj) \
+        type result = obj -> vt.name argumentsNames;\
+        PINC_WINDOW_BACKEND_LEAVE(obj) \
+        return result; \
     }
 
 #define PINC_WINDOW_INTERFACE_PROCEDURE(arguments, name, argumentsNames)\
@@ -123,11 +284,30 @@ typedef struct WindowBackend {
             PincAssertExternal(false, "Function " #name " Is not implemented for this window backend!", true, ;); \
             return; \
         } \
+        PINC_WINDOW_BACKEND_ENTER(obj) \
         obj -> vt.name argumentsNames;\
+        PINC_WINDOW_BACKEND_LEAVE(obj) \
     }
 
-PINC_WINDOW_INTERFACE
+#endif
+
+// Most functions run alongside the backend's background work. The frontend waits for the work itself before deinit.
+#define PINC_WINDOW_BACKEND_ENTER(obj) bool locked = pincWindowBackendLock(obj);
+#define PINC_WINDOW_BACKEND_LEAVE(obj) pincWindowBackendUnlock(obj, locked);
+
+PINC_WINDOW_INTERFACE_GENERAL
+
+#undef PINC_WINDOW_BACKEND_ENTER
+#undef PINC_WINDOW_BACKEND_LEAVE
+
+// The OpenGL functions need the work's results, or at least for it to stop making OpenGL contexts
+#define PINC_WINDOW_BACKEND_ENTER(obj) pincWindowBackendSync(obj);
+#define PINC_WINDOW_BACKEND_LEAVE(obj)
+
+PINC_WINDOW_INTERFACE_OPENGL
 
+#undef PINC_WINDOW_BACKEND_ENTER
+#undef PINC_WINDOW_BACKEND_LEAVE
 #undef PINC_WINDOW_INTERFACE_FUNCTION
 #undef PINC_WINDOW_INTERFACE_PROCEDURE
 
@@ -0,0 +1,213 @@
+#include "pinc_cpu.h"
+
+#if (__GNUC__ || __clang__) && (defined(__x86_64__) || defined(__i386__))
+#   define PINC_CPU_X86 1
+#   include <cpuid.h>
+#   include <immintrin.h>
+#   define PINC_TARGET(_target) __attribute__((target(_target)))
+#   define PINC_CTZ(_value) ((uint32_t)__builtin_ctz(_value))
+#elif _MSC_VER && (defined(_M_X64) || defined(_M_IX86))
+#   define PINC_CPU_X86 1
+#   include <intrin.h>
+#   include <immintrin.h>
+// MSVC lets any function use any instruction set
+#   define PINC_TARGET(_target)
+static P_INLINE uint32_t pincCtzMsvc(uint32_t value) {
+    unsigned long index;
+    _BitScanForward(&index, value);
+    return (uint32_t)index;
+}
+#   define PINC_CTZ(_value) pincCtzMsvc(_value)
+#else
+#   define PINC_CPU_X86 0
+#endif
+
+// Only 64 bit ARM is bothered with, since it always has NEON (and the horizontal operations that 32 bit ARM lacks)
+#if defined(__aarch64__) || defined(_M_ARM64)
+#   define PINC_CPU_NEON 1
+#   include <arm_neon.h>
+#else
+#   define PINC_CPU_NEON 0
+#endif
+
+#if PINC_CPU_X86
+
+static void pincCpuid(uint32_t leaf, uint32_t subleaf, uint32_t out[4]) {
+    #if _MSC_VER
+    int regs[4];
+    __cpuidex(regs, (int)leaf, (int)subleaf);
+    for(int i=0; i<4; ++i) {
+        out[i] = (uint32_t)regs[i];
+    }
+    #else
+    unsigned int a = 0, b = 0, c = 0, d = 0;
+    __cpuid_count(leaf, subleaf, a, b, c, d);
+    out[0] = a; out[1] = b; out[2] = c; out[3] = d;
+    #endif
+}
+
+// Which register states the OS saves on a context switch. Only valid to call if cpuid says OSXSAVE is supported.
+static uint64_t pincXgetbv(void) {
+    #if _MSC_VER
+    return _xgetbv(0);
+    #else
+    uint32_t eax, edx;
+    __asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return ((uint64_t)edx << 32) | eax;
+    #endif
+}
+
+#endif
+
+uint32_t pincQueryCpuFeatures(void) {
+    uint32_t features = 0;
+    #if PINC_CPU_X86
+    uint32_t regs[4];
+    pincCpuid(0, 0, regs);
+    uint32_t maxLeaf = regs[0];
+    if(maxLeaf < 1) {
+        return 0;
+    }
+    pincCpuid(1, 0, regs);
+    if(regs[3] & (1u << 26)) { features |= PincCpuFeature_sse2; }
+    if(regs[2] & (1u << 20)) { features |= PincCpuFeature_sse42; }
+    // AVX registers are only usable if the OS saves them, which is what OSXSAVE + xgetbv is for
+    bool osxsave = (regs[2] & (1u << 27)) != 0;
+    bool avx = (regs[2] & (1u << 28)) != 0;
+    if(osxsave && avx && (pincXgetbv() & 6) == 6 && maxLeaf >= 7) {
+        pincCpuid(7, 0, regs);
+        if(regs[1] & (1u << 5)) { features |= PincCpuFeature_avx2; }
+    }
+    #endif
+    #if PINC_CPU_NEON
+    features |= PincCpuFeature_neon;
+    #endif
+    return features;
+}
+
+// MARK: asciiPrefixLen
+
+#if __GNUC__ || __clang__
+// Reading bytes through a wider type is fine as far as the CPU is concerned, this just tells the compiler the same thing
+typedef uint64_t __attribute__((may_alias)) PincWord;
+#else
+typedef uint64_t PincWord;
+#endif
+
+size_t pincAsciiPrefixLenScalar(uint8_t const* str, size_t len) {
+    size_t i = 0;
+    // Byte at a time until aligned, then a word at a time
+    while(i < len && ((uintptr_t)(str + i) % sizeof(PincWord)) != 0) {
+        if(str[i] & 0x80) {
+            return i;
+        }
+        ++i;
+    }
+    while(i + sizeof(PincWord) <= len) {
+        if(*(PincWord const*)(str + i) & 0x8080808080808080ULL) {
+            break;
+        }
+        i += sizeof(PincWord);
+    }
+    while(i < len && (str[i] & 0x80) == 0) {
+        ++i;
+    }
+    return i;
+}
+
+#if PINC_CPU_X86
+
+PINC_TARGET("sse2") static size_t pincAsciiPrefixLenSse2(uint8_t const* str, size_t len) {
+    size_t i = 0;
+    for(; i + 16 <= len; i += 16) {
+        // The high bit of each byte is exactly what movemask picks out
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((__m128i const*)(str + i)));
+        if(mask) {
+            return i + PINC_CTZ(mask);
+        }
+    }
+    return i + pincAsciiPrefixLenScalar(str + i, len - i);
+}
+
+PINC_TARGET("avx2") static size_t pincAsciiPrefixLenAvx2(uint8_t const* str, size_t len) {
+    size_t i = 0;
+    for(; i + 32 <= len; i += 32) {
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_loadu_si256((__m256i const*)(str + i)));
+        if(mask) {
+            return i + PINC_CTZ(mask);
+        }
+    }
+    return i + pincAsciiPrefixLenSse2(str + i, len - i);
+}
+
+#endif
+
+#if PINC_CPU_NEON
+
+static size_t pincAsciiPrefixLenNeon(uint8_t const* str, size_t len) {
+    size_t i = 0;
+    for(; i + 16 <= len; i += 16) {
+        // NEON has no movemask, so just find the block with a non-ASCII byte and let the scalar loop find where in the block it is
+        if(vmaxvq_u8(vld1q_u8(str + i)) & 0x80) {
+            break;
+        }
+    }
+    return i + pincAsciiPrefixLenScalar(str + i, len - i);
+}
+
+#endif
+
+static void pincCpuKernelsSelect(PincCpuKernels* kernels, uint32_t features) {
+    kernels->asciiPrefixLen = pincAsciiPrefixLenScalar;
+    #if PINC_CPU_X86
+    if(features & PincCpuFeature_avx2) {
+        kernels->asciiPrefixLen = pincAsciiPrefixLenAvx2;
+    } else if(features & PincCpuFeature_sse2) {
+        kernels->asciiPrefixLen = pincAsciiPrefixLenSse2;
+    }
+    #endif
+    #if PINC_CPU_NEON
+    if(features & PincCpuFeature_neon) {
+        kernels->asciiPrefixLen = pincAsciiPrefixLenNeon;
+    }
+    #endif
+    // Only used on some architectures
+    P_UNUSED(features);
+}
+
+// MARK: Process-wide selection
+
+static PincCpuKernels const pincCpuKernelsPortable = {
+    .asciiPrefixLen = pincAsciiPrefixLenScalar,
+};
+
+// Written once by whichever thread gets to pincCpuInit first, and only read after that.
+// 0: not picked, 1: being picked, 2: ready
+static PincAtomicInt32 pincCpuSelectState; //NOLINT
+static PincCpuKernels pincCpuKernelsSelected; //NOLINT
+static uint32_t pincCpuFeaturesDetected; //NOLINT
+
+void pincCpuInit(void) {
+    int32_t expected = 0;
+    if(!pincAtomicCompareExchangeInt32(&pincCpuSelectState, &expected, 1)) {
+        // Already done, or another thread is on it. Until it's done, everyone gets the portable versions.
+        return;
+    }
+    pincCpuFeaturesDetected = pincQueryCpuFeatures();
+    pincCpuKernelsSelect(&pincCpuKernelsSelected, pincCpuFeaturesDetected);
+    pincAtomicStoreInt32(&pincCpuSelectState, 2);
+}
+
+PincCpuKernels const* pincCpuKernels(void) {
+    if(pincAtomicLoadInt32(&pincCpuSelectState) != 2) {
+        return &pincCpuKernelsPortable;
+    }
+    return &pincCpuKernelsSelected;
+}
+
+uint32_t pincCpuFeatures(void) {
+    if(pincAtomicLoadInt32(&pincCpuSelectState) != 2) {
+        return 0;
+    }
+    return pincCpuFeaturesDetected;
+}
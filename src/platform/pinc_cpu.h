@@ -0,0 +1,43 @@
+#ifndef PINC_CPU_H
+#define PINC_CPU_H
+
+#include "pinc_platform.h"
+
+// CPU feature detection, and picking the fastest implementation of Pinc's byte crunching routines for the CPU it's actually running on.
+// This depends on the compiler and architecture rather than the OS, so it is built even with PINC_USE_CUSTOM_PLATFORM_IMPLEMENTATION.
+// Vectorized kernels are compiled with per-function target attributes, so everything else is still built for the baseline architecture.
+
+typedef enum {
+    PincCpuFeature_sse2 = 1 << 0,
+    PincCpuFeature_sse42 = 1 << 1,
+    PincCpuFeature_avx2 = 1 << 2,
+    PincCpuFeature_neon = 1 << 3,
+} PincCpuFeature;
+
+/// @brief Detect the features of the CPU. cpuid is not exactly free, so call this once and keep the result.
+/// @return A bitmask of PincCpuFeature
+uint32_t pincQueryCpuFeatures(void);
+
+typedef size_t (*PincAsciiPrefixLenFn)(uint8_t const* str, size_t len);
+
+// The best implementation of each routine for the current CPU.
+typedef struct {
+    // Returns the number of bytes at the start of str that are ASCII (less than 0x80)
+    PincAsciiPrefixLenFn asciiPrefixLen;
+} PincCpuKernels;
+
+// The CPU doesn't change while the process is running, so the kernels are picked once for the whole process rather than per instance.
+// Detect the CPU features and pick the kernels. Only the first call does anything. Safe to call from any thread.
+void pincCpuInit(void);
+
+// The kernels picked by pincCpuInit, or the portable versions if it hasn't finished yet. Never null.
+PincCpuKernels const* pincCpuKernels(void);
+
+// The bitmask of PincCpuFeature found by pincCpuInit, or 0 if it hasn't finished yet
+uint32_t pincCpuFeatures(void);
+
+// Portable implementations, which are also the fallback for before the kernels have been selected
+
+size_t pincAsciiPrefixLenScalar(uint8_t const* str, size_t len);
+
+#endif
@@ -13,9 +13,89 @@
 #elif defined (__WIN32__) || (_WIN32)
 
 #include "pinc_platform_win32.c.inc"
+// Win32 has no memcpy and friends without the C runtime, so it always uses the built-in ones
+#define P_PLATFORM_NEEDS_BUILTIN_MEMORY 1
 
 #else
 
 #error "No implementation for this platform!"
 
 #endif
+
+#ifndef P_PLATFORM_NEEDS_BUILTIN_MEMORY
+# define P_PLATFORM_NEEDS_BUILTIN_MEMORY 0
+#endif
+
+#if PINC_USE_BUILTIN_MEMORY_FUNCTIONS || P_PLATFORM_NEEDS_BUILTIN_MEMORY
+#include "pinc_platform_mem.c.inc"
+#endif
+
+// Platform independent functionality, built on top of the functions above (or the user's own implementation of them)
+
+#include "pinc_platform.h"
+
+#if PINC_USE_CUSTOM_PLATFORM_IMPLEMENTATION
+// Custom platform implementations predate pincLibrarySymbols, so they get this simple version on top of pincLibrarySymbol
+size_t pincLibrarySymbols(void* library, uint8_t const* const* symbolNamesUtf8, size_t const* nameSizes, pincPFN* outSymbols, size_t count) {
+    size_t found = 0;
+    for(size_t i=0; i<count; ++i) {
+        outSymbols[i] = pincLibrarySymbol(library, symbolNamesUtf8[i], nameSizes[i]);
+        if(outSymbols[i]) {
+            found++;
+        }
+    }
+    return found;
+}
+#endif
+
+#if _MSC_VER
+# include <intrin.h>
+#endif
+
+// Let the CPU know it's in a spin loop, so it can save some power and give a hyperthread sibling the core
+static P_INLINE void pincSpinPause(void) {
+    #if (__GNUC__ || __clang__) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_ia32_pause();
+    #elif (__GNUC__ || __clang__) && defined(__aarch64__)
+    __asm__ __volatile__("yield");
+    #elif _MSC_VER && (defined(_M_X64) || defined(_M_IX86))
+    _mm_pause();
+    #endif
+}
+
+// Bounds of the spin stretch at the end of a wait. Even the best schedulers overshoot a bit,
+// and a sleep that overshoots by more than a few milliseconds is a system under heavy load, not something worth burning a core over.
+#define PINC_WAIT_MIN_SPIN_NANOS 50000
+#define PINC_WAIT_MAX_SPIN_NANOS 4000000
+
+// How long before a deadline to stop sleeping and start spinning. Per-thread where possible, since scheduling may differ between threads.
+// Without thread locals it's shared, and concurrent waits can only throw off the estimate a bit.
+static P_THREAD_LOCAL int64_t pincWaitSpinNanos = 1000000; //NOLINT: this is a heuristic, not state
+
+void pincWaitUntilNanos(int64_t deadline) {
+    int64_t now = pincCurrentTimeNanos();
+    while(deadline - now > pincWaitSpinNanos) {
+        int64_t requested = deadline - now - pincWaitSpinNanos;
+        pincSleepNanos(requested);
+        int64_t after = pincCurrentTimeNanos();
+        // Leave some headroom on top of the overshoot, since it varies from one sleep to the next
+        int64_t overshoot = (after - now) - requested;
+        int64_t margin = overshoot + overshoot / 4;
+        // Jump up to a worse overshoot immediately, but come down slowly so one lucky sleep doesn't cause a missed deadline
+        if(margin > pincWaitSpinNanos) {
+            pincWaitSpinNanos = margin;
+        } else {
+            pincWaitSpinNanos -= (pincWaitSpinNanos - margin) / 16;
+        }
+        if(pincWaitSpinNanos < PINC_WAIT_MIN_SPIN_NANOS) {
+            pincWaitSpinNanos = PINC_WAIT_MIN_SPIN_NANOS;
+        } else if(pincWaitSpinNanos > PINC_WAIT_MAX_SPIN_NANOS) {
+            pincWaitSpinNanos = PINC_WAIT_MAX_SPIN_NANOS;
+        }
+        now = after;
+    }
+    while(now < deadline) {
+        pincSpinPause();
+        now = pincCurrentTimeNanos();
+    }
+}
@@ -14,17 +14,37 @@
 #   define P_NORETURN __attribute__ ((__noreturn__))
 #   define P_INLINE inline
 #   define P_RESTRICT restrict
+#   define P_THREAD_LOCAL __thread
+#   define P_HAVE_THREAD_LOCAL 1
 # elif _MSC_VER
 #   define P_UNUSED(var) (void) var
 #   define P_NORETURN
 #   define P_INLINE __inline
 #   define P_RESTRICT __restrict
+#   define P_THREAD_LOCAL __declspec(thread)
+#   define P_HAVE_THREAD_LOCAL 1
 # else
 // Assume other compilers do not support these at all
 #   define P_UNUSED(var)
 #   define P_NORETURN
 #   define P_INLINE
 #   define P_RESTRICT
+// C11 has thread locals built in, so that's at least something
+#   if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+#     define P_THREAD_LOCAL _Thread_local
+#     define P_HAVE_THREAD_LOCAL 1
+#   else
+#     define P_THREAD_LOCAL
+#     define P_HAVE_THREAD_LOCAL 0
+#   endif
+#endif
+
+// For the thread locals that are read on every API call. In a shared library, the default model looks them up with a call to __tls_get_addr each time.
+// Initial exec reads them at a fixed offset from the thread pointer instead, which costs a little of the static TLS space the loader keeps for libraries loaded with dlopen.
+#if (__GNUC__ || __clang__) && defined(__ELF__)
+#   define P_TLS_INITIAL_EXEC __attribute__ ((tls_model("initial-exec")))
+#else
+#   define P_TLS_INITIAL_EXEC
 #endif
 
 typedef void (*pincPFN)(void);
@@ -76,6 +96,15 @@ void* pincLoadLibrary(uint8_t const* nameUtf8, size_t nameSize);
 /// @return A pointer to that symbol.
 pincPFN pincLibrarySymbol(void* library, uint8_t const* symbolNameUtf8, size_t nameSize);
 
+/// @brief Load a whole table of symbols from a library at once. Unlike calling pincLibrarySymbol in a loop, this does not allocate for each name.
+/// @param library The library to load from
+/// @param symbolNamesUtf8 The name of each symbol, encoded in UTF8
+/// @param nameSizes The number of bytes in each name
+/// @param outSymbols Where to put each symbol. Symbols that could not be found are set to null.
+/// @param count The number of symbols to load
+/// @return The number of symbols that were found
+size_t pincLibrarySymbols(void* library, uint8_t const* const* symbolNamesUtf8, size_t const* nameSizes, pincPFN* outSymbols, size_t count);
+
 /// @brief Unload a library that is no longer needed.
 /// @param library The library to unload.
 void pincUnloadLibrary(void* library);
@@ -127,4 +156,172 @@ size_t pincBufPrintUint64(char* buf, size_t capacity, uint64_t value);
 // The only strict requirement is that it is relatively consistent so two time values can be compared with decent accuracy.
 int64_t pincCurrentTimeMillis(void);
 
+// The same monotonic time counter, but in nanoseconds. Resolution depends on the platform, but it should be well under a millisecond.
+int64_t pincCurrentTimeNanos(void);
+
+/// @brief Put the calling thread to sleep for roughly the given amount of time.
+///        It may wake up late (often by more than a millisecond, depending on the platform and scheduler), and it may wake up early.
+void pincSleepNanos(int64_t nanos);
+
+// files
+// Paths are utf8 and not null terminated.
+
+/// @brief Read a whole file, or as much of it as fits.
+/// @param buffer where to put the file's contents. May be null if capacity is 0, to just get the size.
+/// @param outSize set to the size of the whole file, even if it doesn't fit in the buffer.
+/// @return false if the file could not be opened or read.
+bool pincFileRead(uint8_t const* pathUtf8, size_t pathSize, void* buffer, size_t capacity, size_t* outSize);
+
+/// @brief Replace a file with new contents, creating it if needed.
+///        Either the old file stays as it was or it's completely replaced - a crash in the middle never leaves a partial file behind.
+/// @return false if the file could not be written.
+bool pincFileWrite(uint8_t const* pathUtf8, size_t pathSize, void const* data, size_t size);
+
+/// @brief Delete a file. Deleting one that doesn't exist is not a failure.
+/// @return false if the file exists but could not be deleted.
+bool pincFileDelete(uint8_t const* pathUtf8, size_t pathSize);
+
+// threading
+
+// Threads, mutexes, condition variables, and thread local storage keys are all opaque pointers, allocated by the platform implementation.
+// Any of the create functions may return null if the platform does not support threads (or ran out of resources), so callers must be ready to run single threaded.
+// A custom platform implementation without threads can implement all of these as stubs that return null / do nothing.
+
+typedef void (*PincThreadFn)(void* arg);
+
+/// @brief Start a new thread running fn(arg).
+/// @return The thread, or null if it could not be created. Every thread must be joined exactly once.
+void* pincThreadCreate(PincThreadFn fn, void* arg);
+
+/// @brief Wait for a thread to finish, then free it.
+void pincThreadJoin(void* thread);
+
+/// @return A new mutex, or null if it could not be created. Mutexes are not recursive.
+void* pincMutexCreate(void);
+
+void pincMutexDestroy(void* mutex);
+
+void pincMutexLock(void* mutex);
+
+/// @return True if the mutex was locked, false if it was already locked by someone else
+bool pincMutexTryLock(void* mutex);
+
+void pincMutexUnlock(void* mutex);
+
+/// @return A new condition variable, or null if it could not be created.
+void* pincCondCreate(void);
+
+void pincCondDestroy(void* cond);
+
+/// @brief Unlock mutex, wait for the condition variable to be signaled, then lock mutex again. May wake up spuriously, so always check the actual condition in a loop.
+void pincCondWait(void* cond, void* mutex);
+
+/// @brief Same as pincCondWait, but gives up after roughly the given amount of time.
+/// @return False if it timed out, true otherwise (including spurious wakeups)
+bool pincCondWaitTimeoutNanos(void* cond, void* mutex, int64_t nanos);
+
+/// @brief Wake up at least one thread waiting on cond
+void pincCondSignal(void* cond);
+
+/// @brief Wake up every thread waiting on cond
+void pincCondBroadcast(void* cond);
+
+// For thread local storage whose lifetime is not the whole program. Otherwise, P_THREAD_LOCAL is simpler (and faster) where it is supported.
+
+/// @return A new thread local storage key, which starts out null on every thread. Returns null if it could not be created.
+void* pincTlsCreate(void);
+
+/// @brief Free a thread local storage key. Does not do anything with the values that threads stored in it.
+void pincTlsDestroy(void* key);
+
+void* pincTlsGet(void* key);
+
+void pincTlsSet(void* key, void* value);
+
+// Atomics. These depend on the compiler rather than the platform, so they live entirely in this header.
+// All operations are sequentially consistent. Use them through the functions, not by touching value directly.
+// P_HAVE_ATOMICS is 0 if the compiler has no known way to do atomics, in which case the fallback is plain (non-atomic) memory access,
+// which is only correct if nothing actually uses more than one thread.
+
+#if __GNUC__ || __clang__
+#   define P_HAVE_ATOMICS 1
+typedef struct { int32_t value; } PincAtomicInt32;
+typedef struct { void* value; } PincAtomicPtr;
+static P_INLINE int32_t pincAtomicLoadInt32(PincAtomicInt32* a) { return __atomic_load_n(&a->value, __ATOMIC_SEQ_CST); }
+static P_INLINE void pincAtomicStoreInt32(PincAtomicInt32* a, int32_t v) { __atomic_store_n(&a->value, v, __ATOMIC_SEQ_CST); }
+static P_INLINE int32_t pincAtomicFetchAddInt32(PincAtomicInt32* a, int32_t v) { return __atomic_fetch_add(&a->value, v, __ATOMIC_SEQ_CST); }
+static P_INLINE int32_t pincAtomicExchangeInt32(PincAtomicInt32* a, int32_t v) { return __atomic_exchange_n(&a->value, v, __ATOMIC_SEQ_CST); }
+static P_INLINE bool pincAtomicCompareExchangeInt32(PincAtomicInt32* a, int32_t* expected, int32_t desired) { return __atomic_compare_exchange_n(&a->value, expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST); }
+static P_INLINE void* pincAtomicLoadPtr(PincAtomicPtr* a) { return __atomic_load_n(&a->value, __ATOMIC_SEQ_CST); }
+static P_INLINE void pincAtomicStorePtr(PincAtomicPtr* a, void* v) { __atomic_store_n(&a->value, v, __ATOMIC_SEQ_CST); }
+static P_INLINE void* pincAtomicExchangePtr(PincAtomicPtr* a, void* v) { return __atomic_exchange_n(&a->value, v, __ATOMIC_SEQ_CST); }
+static P_INLINE bool pincAtomicCompareExchangePtr(PincAtomicPtr* a, void** expected, void* desired) { return __atomic_compare_exchange_n(&a->value, expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST); }
+#elif _MSC_VER
+#   include <intrin.h>
+#   define P_HAVE_ATOMICS 1
+typedef struct { long volatile value; } PincAtomicInt32;
+typedef struct { void* volatile value; } PincAtomicPtr;
+// The Interlocked functions are all full barriers. Loads are done as a compare exchange that never changes anything, and stores as an exchange.
+static P_INLINE int32_t pincAtomicLoadInt32(PincAtomicInt32* a) { return (int32_t)_InterlockedCompareExchange(&a->value, 0, 0); }
+static P_INLINE void pincAtomicStoreInt32(PincAtomicInt32* a, int32_t v) { _InterlockedExchange(&a->value, (long)v); }
+static P_INLINE int32_t pincAtomicFetchAddInt32(PincAtomicInt32* a, int32_t v) { return (int32_t)_InterlockedExchangeAdd(&a->value, (long)v); }
+static P_INLINE int32_t pincAtomicExchangeInt32(PincAtomicInt32* a, int32_t v) { return (int32_t)_InterlockedExchange(&a->value, (long)v); }
+static P_INLINE bool pincAtomicCompareExchangeInt32(PincAtomicInt32* a, int32_t* expected, int32_t desired) {
+    long old = _InterlockedCompareExchange(&a->value, (long)desired, (long)*expected);
+    if(old == (long)*expected) { return true; }
+    *expected = (int32_t)old;
+    return false;
+}
+static P_INLINE void* pincAtomicLoadPtr(PincAtomicPtr* a) { return _InterlockedCompareExchangePointer(&a->value, 0, 0); }
+static P_INLINE void pincAtomicStorePtr(PincAtomicPtr* a, void* v) { _InterlockedExchangePointer(&a->value, v); }
+static P_INLINE void* pincAtomicExchangePtr(PincAtomicPtr* a, void* v) { return _InterlockedExchangePointer(&a->value, v); }
+static P_INLINE bool pincAtomicCompareExchangePtr(PincAtomicPtr* a, void** expected, void* desired) {
+    void* old = _InterlockedCompareExchangePointer(&a->value, desired, *expected);
+    if(old == *expected) { return true; }
+    *expected = old;
+    return false;
+}
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L && !defined(__STDC_NO_ATOMICS__)
+#   include <stdatomic.h>
+#   define P_HAVE_ATOMICS 1
+typedef struct { _Atomic int32_t value; } PincAtomicInt32;
+typedef struct { _Atomic(void*) value; } PincAtomicPtr;
+static P_INLINE int32_t pincAtomicLoadInt32(PincAtomicInt32* a) { return atomic_load(&a->value); }
+static P_INLINE void pincAtomicStoreInt32(PincAtomicInt32* a, int32_t v) { atomic_store(&a->value, v); }
+static P_INLINE int32_t pincAtomicFetchAddInt32(PincAtomicInt32* a, int32_t v) { return atomic_fetch_add(&a->value, v); }
+static P_INLINE int32_t pincAtomicExchangeInt32(PincAtomicInt32* a, int32_t v) { return atomic_exchange(&a->value, v); }
+static P_INLINE bool pincAtomicCompareExchangeInt32(PincAtomicInt32* a, int32_t* expected, int32_t desired) { return atomic_compare_exchange_strong(&a->value, expected, desired); }
+static P_INLINE void* pincAtomicLoadPtr(PincAtomicPtr* a) { return atomic_load(&a->value); }
+static P_INLINE void pincAtomicStorePtr(PincAtomicPtr* a, void* v) { atomic_store(&a->value, v); }
+static P_INLINE void* pincAtomicExchangePtr(PincAtomicPtr* a, void* v) { return atomic_exchange(&a->value, v); }
+static P_INLINE bool pincAtomicCompareExchangePtr(PincAtomicPtr* a, void** expected, void* desired) { return atomic_compare_exchange_strong(&a->value, expected, desired); }
+#else
+#   define P_HAVE_ATOMICS 0
+typedef struct { int32_t value; } PincAtomicInt32;
+typedef struct { void* value; } PincAtomicPtr;
+static P_INLINE int32_t pincAtomicLoadInt32(PincAtomicInt32* a) { return a->value; }
+static P_INLINE void pincAtomicStoreInt32(PincAtomicInt32* a, int32_t v) { a->value = v; }
+static P_INLINE int32_t pincAtomicFetchAddInt32(PincAtomicInt32* a, int32_t v) { int32_t old = a->value; a->value += v; return old; }
+static P_INLINE int32_t pincAtomicExchangeInt32(PincAtomicInt32* a, int32_t v) { int32_t old = a->value; a->value = v; return old; }
+static P_INLINE bool pincAtomicCompareExchangeInt32(PincAtomicInt32* a, int32_t* expected, int32_t desired) {
+    if(a->value == *expected) { a->value = desired; return true; }
+    *expected = a->value;
+    return false;
+}
+static P_INLINE void* pincAtomicLoadPtr(PincAtomicPtr* a) { return a->value; }
+static P_INLINE void pincAtomicStorePtr(PincAtomicPtr* a, void* v) { a->value = v; }
+static P_INLINE void* pincAtomicExchangePtr(PincAtomicPtr* a, void* v) { void* old = a->value; a->value = v; return old; }
+static P_INLINE bool pincAtomicCompareExchangePtr(PincAtomicPtr* a, void** expected, void* desired) {
+    if(a->value == *expected) { a->value = desired; return true; }
+    *expected = a->value;
+    return false;
+}
+#endif
+
+// Functions implemented in pinc_platform.c on top of the above, so a custom platform implementation does not need to provide these
+
+/// @brief Wait until pincCurrentTimeNanos() reaches deadline. Sleeps for most of the wait, then spins for the last stretch.
+///        How long that stretch is gets calibrated from how badly previous sleeps on the calling thread overshot.
+void pincWaitUntilNanos(int64_t deadline);
+
 #endif
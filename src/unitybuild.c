@@ -9,8 +9,12 @@
 #include "libs/pinc_utf8.c"
 #include "libs/pinc_arena.c"
 #include "pinc_main.c"
+#include "pinc_log.c"
+#include "pinc_capability_cache.c"
 #include "pinc_sdl2.c"
+#include "pinc_none.c"
 #include "platform/pinc_platform.c"
+#include "platform/pinc_cpu.c"
 
 // NOLINTEND
 